@@ -0,0 +1,73 @@
+#ifndef BYTE_ORDER_H
+#define BYTE_ORDER_H
+
+#include <cstdint>
+#include <cstring>
+
+// Little-endian field access for the binary file formats
+namespace ByteOrder {
+    // Raw sample blocks are copied byte for byte, so only little-endian hosts can use them
+    inline bool isLittleEndian() {
+        uint16_t probe = 1;
+        unsigned char first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    inline void putU16(unsigned char* out, uint16_t value) {
+        out[0] = static_cast<unsigned char>(value);
+        out[1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    inline void putU32(unsigned char* out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+
+    inline void putU64(unsigned char* out, uint64_t value) {
+        for (int i = 0; i < 8; ++i) out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+
+    inline void putF32(unsigned char* out, float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putU32(out, bits);
+    }
+
+    inline void putF64(unsigned char* out, double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putU64(out, bits);
+    }
+
+    inline uint16_t getU16(const unsigned char* in) {
+        return static_cast<uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    inline uint32_t getU32(const unsigned char* in) {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(in[i]) << (8 * i);
+        return value;
+    }
+
+    inline uint64_t getU64(const unsigned char* in) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+        return value;
+    }
+
+    inline float getF32(const unsigned char* in) {
+        uint32_t bits = getU32(in);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    inline double getF64(const unsigned char* in) {
+        uint64_t bits = getU64(in);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
+
+#endif // BYTE_ORDER_H
@@ -0,0 +1,212 @@
+#include "CoherenceCalculator.h"
+#include "PhysicsConstants.h"
+#include "ParallelFor.h"
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <limits>
+
+namespace {
+
+// FWHM = 2 * sqrt(2 ln 2) * sigma
+constexpr double FWHM_TO_SIGMA = 1.0 / 2.3548200450309493;
+
+}
+
+CoherenceCalculator::CoherenceCalculator(unsigned int numThreads) : numThreads_(1) {
+    setThreadCount(numThreads);
+}
+
+void CoherenceCalculator::setThreadCount(unsigned int numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    numThreads_ = std::max(1u, numThreads);
+}
+
+CoherenceResult CoherenceCalculator::calculateQuadrature(
+    const CoherenceParameters& params,
+    int numWavelengthSamples,
+    int numSourceSamples) {
+
+    CoherenceResult result = prepareResult(params);
+    if (result.positions.empty()) return result;
+
+    // Midpoint rule: Gaussian spectrum over ±3σ, uniform source over its width.
+    // Broad spectra are truncated at λ = 0; the weights are renormalized below.
+    int wavelengthCount = params.bandwidth > 0.0 ? std::max(1, numWavelengthSamples) : 1;
+    int sourceCount = params.sourceWidth > 0.0 ? std::max(1, numSourceSamples) : 1;
+    double sigma = params.bandwidth * FWHM_TO_SIGMA;
+    double lowerLimit = sigma > 0.0 ? std::max(-3.0, -params.centerWavelength / sigma) : -3.0;
+
+    std::vector<SourceSample> samples;
+    samples.reserve(static_cast<size_t>(wavelengthCount) * sourceCount);
+
+    double totalWeight = 0.0;
+    for (int i = 0; i < wavelengthCount; ++i) {
+        double u = wavelengthCount > 1 ? lowerLimit + (3.0 - lowerLimit) * (i + 0.5) / wavelengthCount : 0.0;
+        double spectralWeight = std::exp(-0.5 * u * u);
+
+        for (int j = 0; j < sourceCount; ++j) {
+            double s = sourceCount > 1 ? params.sourceWidth * ((j + 0.5) / sourceCount - 0.5) : 0.0;
+            samples.push_back({params.centerWavelength + u * sigma, s, spectralWeight});
+            totalWeight += spectralWeight;
+        }
+    }
+
+    std::vector<double> sinTheta(result.positions.size());
+    for (size_t p = 0; p < sinTheta.size(); ++p) {
+        double y = result.positions[p];
+        sinTheta[p] = y / std::sqrt(y * y + params.screenDistance * params.screenDistance);
+    }
+
+    // Parallel across screen tiles; each tile sees every sample
+    constexpr size_t TILE = 256;
+    size_t numPoints = sinTheta.size();
+    size_t numTiles = (numPoints + TILE - 1) / TILE;
+
+    parallelFor(numTiles, numThreads_, [&](size_t tile) {
+        size_t first = tile * TILE;
+        size_t count = std::min(TILE, numPoints - first);
+        accumulate(sinTheta.data() + first, count, params, samples.data(), samples.size(),
+                   result.intensity.data() + first);
+    });
+
+    finishResult(result, params, totalWeight);
+    return result;
+}
+
+CoherenceResult CoherenceCalculator::calculateMonteCarlo(
+    const CoherenceParameters& params,
+    size_t numSamples,
+    uint64_t seed) {
+
+    CoherenceResult result = prepareResult(params);
+    if (result.positions.empty() || numSamples == 0) return result;
+
+    size_t numPoints = result.positions.size();
+    std::vector<double> sinTheta(numPoints);
+    for (size_t p = 0; p < numPoints; ++p) {
+        double y = result.positions[p];
+        sinTheta[p] = y / std::sqrt(y * y + params.screenDistance * params.screenDistance);
+    }
+
+    size_t numBatches = std::min(MONTE_CARLO_BATCHES, numSamples);
+    size_t batchSize = (numSamples + numBatches - 1) / numBatches;
+    double sigma = params.bandwidth * FWHM_TO_SIGMA;
+
+    std::vector<double> partials(numBatches * numPoints, 0.0);
+
+    parallelFor(numBatches, numThreads_, [&](size_t batch) {
+        size_t first = batch * batchSize;
+        size_t count = first < numSamples ? std::min(batchSize, numSamples - first) : 0;
+
+        std::seed_seq sequence{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+                               static_cast<uint32_t>(batch)};
+        std::mt19937_64 generator(sequence);
+        std::normal_distribution<double> spectrum(params.centerWavelength, sigma > 0.0 ? sigma : 1.0);
+        std::uniform_real_distribution<double> source(-0.5, 0.5);
+
+        std::vector<SourceSample> samples(count);
+        for (auto& sample : samples) {
+            // Redraw non-positive wavelengths: the spectrum is truncated at λ = 0
+            sample.wavelength = params.centerWavelength;
+            if (sigma > 0.0) {
+                do {
+                    sample.wavelength = spectrum(generator);
+                } while (sample.wavelength <= 0.0);
+            }
+            sample.sourcePosition = params.sourceWidth * source(generator);
+            sample.weight = 1.0;
+        }
+
+        accumulate(sinTheta.data(), numPoints, params, samples.data(), samples.size(),
+                   partials.data() + batch * numPoints);
+    });
+
+    // Reduce in batch order so the sum is identical for any thread count
+    for (size_t batch = 0; batch < numBatches; ++batch) {
+        const double* partial = partials.data() + batch * numPoints;
+        for (size_t p = 0; p < numPoints; ++p) {
+            result.intensity[p] += partial[p];
+        }
+    }
+
+    finishResult(result, params, static_cast<double>(numSamples));
+    return result;
+}
+
+double CoherenceCalculator::calculateVisibility(const CoherenceResult& result, const CoherenceParameters& params) const {
+    if (result.intensity.empty() || params.slitSeparation <= 0.0) return 0.0;
+
+    // Look at the fringes within one period of the screen center
+    double fringePeriod = params.centerWavelength * params.screenDistance / params.slitSeparation;
+    double maxIntensity = 0.0;
+    double minIntensity = std::numeric_limits<double>::max();
+
+    for (size_t p = 0; p < result.positions.size(); ++p) {
+        if (std::abs(result.positions[p]) <= fringePeriod) {
+            maxIntensity = std::max(maxIntensity, result.intensity[p]);
+            minIntensity = std::min(minIntensity, result.intensity[p]);
+        }
+    }
+
+    if (maxIntensity + minIntensity <= 0.0 || minIntensity > maxIntensity) return 0.0;
+    return (maxIntensity - minIntensity) / (maxIntensity + minIntensity);
+}
+
+CoherenceResult CoherenceCalculator::prepareResult(const CoherenceParameters& params) const {
+    CoherenceResult result = {{}, {}, 0.0, 0.0, 0.0};
+
+    if (params.numPoints < 2 || params.centerWavelength <= 0.0) return result;
+
+    size_t numPoints = static_cast<size_t>(params.numPoints);
+    double dy = params.screenWidth / (params.numPoints - 1);
+
+    result.positions.resize(numPoints);
+    result.intensity.assign(numPoints, 0.0);
+    for (size_t p = 0; p < numPoints; ++p) {
+        result.positions[p] = -params.screenWidth / 2.0 + p * dy;
+    }
+
+    return result;
+}
+
+void CoherenceCalculator::finishResult(CoherenceResult& result, const CoherenceParameters& params, double totalWeight) const {
+    // Each sample contributes at most 2 (fully constructive)
+    if (totalWeight > 0.0) {
+        for (double& value : result.intensity) {
+            value /= 2.0 * totalWeight;
+        }
+    }
+
+    double lambdaSquared = params.centerWavelength * params.centerWavelength;
+    result.coherenceLength = params.bandwidth > 0.0 ? lambdaSquared / params.bandwidth : 0.0;
+    result.coherenceWidth = params.sourceWidth > 0.0 ? params.centerWavelength * params.sourceDistance / params.sourceWidth : 0.0;
+    result.visibility = calculateVisibility(result, params);
+}
+
+void CoherenceCalculator::accumulate(
+    const double* sinTheta,
+    size_t numPoints,
+    const CoherenceParameters& params,
+    const SourceSample* samples,
+    size_t numSamples,
+    double* output) const {
+
+    for (size_t i = 0; i < numSamples; ++i) {
+        const SourceSample& sample = samples[i];
+
+        // Path difference d*(sinθ + sinφ), φ the source angle seen from the slits
+        double waveNumber = Physics::TWO_PI * params.slitSeparation / sample.wavelength;
+        double s = sample.sourcePosition;
+        double sourceSin = s / std::sqrt(s * s + params.sourceDistance * params.sourceDistance);
+        double offset = waveNumber * sourceSin;
+        double weight = sample.weight;
+
+        for (size_t p = 0; p < numPoints; ++p) {
+            output[p] += weight * (1.0 + std::cos(waveNumber * sinTheta[p] + offset));
+        }
+    }
+}
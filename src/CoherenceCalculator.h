@@ -0,0 +1,80 @@
+#ifndef COHERENCE_CALCULATOR_H
+#define COHERENCE_CALCULATOR_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Double-slit experiment lit by a partially coherent source: a uniform slit
+// source of finite width with a Gaussian spectrum
+struct CoherenceParameters {
+    double centerWavelength = 500e-9;
+    double bandwidth = 0.0;          // Spectral FWHM, 0 for monochromatic
+    double slitSeparation = 1e-4;
+    double screenDistance = 1.0;
+    double sourceWidth = 0.0;        // 0 for a point source
+    double sourceDistance = 0.1;     // Source to slit plane
+    double screenWidth = 0.02;
+    int numPoints = 1000;
+};
+
+struct CoherenceResult {
+    std::vector<double> positions;
+    std::vector<double> intensity;   // Normalized so fully coherent fringes peak at 1
+    double visibility;               // Measured on the central fringes
+    double coherenceLength;          // λ² / Δλ
+    double coherenceWidth;           // λ * sourceDistance / sourceWidth
+};
+
+class CoherenceCalculator {
+public:
+    CoherenceCalculator(unsigned int numThreads = 0);  // 0 = hardware concurrency
+    ~CoherenceCalculator() = default;
+
+    // Deterministic midpoint quadrature over wavelength and source position
+    CoherenceResult calculateQuadrature(
+        const CoherenceParameters& params,
+        int numWavelengthSamples = 64,
+        int numSourceSamples = 32
+    );
+
+    // Monte Carlo over (wavelength, source point) pairs. Samples are split into
+    // fixed batches seeded from (seed, batch), so results do not depend on the
+    // thread count.
+    CoherenceResult calculateMonteCarlo(
+        const CoherenceParameters& params,
+        size_t numSamples = 20000,
+        uint64_t seed = 1
+    );
+
+    double calculateVisibility(const CoherenceResult& result, const CoherenceParameters& params) const;
+
+    void setThreadCount(unsigned int numThreads);
+    unsigned int getThreadCount() const { return numThreads_; }
+
+private:
+    struct SourceSample {
+        double wavelength;
+        double sourcePosition;
+        double weight;
+    };
+
+    CoherenceResult prepareResult(const CoherenceParameters& params) const;
+    void finishResult(CoherenceResult& result, const CoherenceParameters& params, double totalWeight) const;
+
+    // Adds weight * (1 + cos(phase)) for every sample to every screen point
+    void accumulate(
+        const double* sinTheta,
+        size_t numPoints,
+        const CoherenceParameters& params,
+        const SourceSample* samples,
+        size_t numSamples,
+        double* output
+    ) const;
+
+    unsigned int numThreads_;
+
+    static constexpr size_t MONTE_CARLO_BATCHES = 64;
+};
+
+#endif // COHERENCE_CALCULATOR_H
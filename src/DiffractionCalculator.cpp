@@ -0,0 +1,198 @@
+#include "DiffractionCalculator.h"
+#include "PhysicsConstants.h"
+#include <cmath>
+#include <algorithm>
+
+DiffractionPattern DiffractionCalculator::calculateFraunhoferPattern(
+    const std::vector<double>& aperture,
+    double apertureSpacing,
+    double wavelength,
+    double screenDistance,
+    size_t paddingFactor) {
+    
+    DiffractionPattern pattern;
+    
+    if (aperture.empty() || apertureSpacing <= 0.0 || wavelength <= 0.0) return pattern;
+    
+    // Zero-pad the mask; the far field is the Fourier transform of the aperture
+    size_t fftSize = analyzer_.nextPowerOfTwo(aperture.size() * std::max<size_t>(paddingFactor, 1));
+    std::vector<Complex> field(fftSize, Complex(0.0, 0.0));
+    for (size_t i = 0; i < aperture.size(); ++i) {
+        field[i] = Complex(aperture[i], 0.0);
+    }
+    
+    auto spectrum = analyzer_.fft(field);
+    
+    pattern.positions.reserve(fftSize);
+    pattern.intensity.reserve(fftSize);
+    
+    // Walk the spectrum from negative to positive spatial frequencies (fftshift)
+    double frequencyStep = 1.0 / (fftSize * apertureSpacing);
+    long half = static_cast<long>(fftSize / 2);
+    double maxIntensity = 0.0;
+    
+    for (long k = -half; k < half; ++k) {
+        double sinTheta = wavelength * k * frequencyStep;
+        if (std::abs(sinTheta) >= 1.0) continue;  // Evanescent, never reaches the screen
+        
+        const Complex& value = spectrum[(k + static_cast<long>(fftSize)) % fftSize];
+        double intensity = value.real * value.real + value.imag * value.imag;
+        
+        pattern.positions.push_back(screenDistance * sinTheta / std::sqrt(1.0 - sinTheta * sinTheta));
+        pattern.intensity.push_back(intensity);
+        maxIntensity = std::max(maxIntensity, intensity);
+    }
+    
+    if (maxIntensity > 0.0) {
+        for (double& value : pattern.intensity) {
+            value /= maxIntensity;
+        }
+    }
+    
+    return pattern;
+}
+
+DiffractionPattern2D DiffractionCalculator::calculateFraunhoferPattern2D(
+    const std::vector<double>& aperture,
+    size_t rows,
+    size_t cols,
+    double apertureSpacing,
+    double wavelength,
+    double screenDistance,
+    size_t paddingFactor) {
+    
+    DiffractionPattern2D pattern = {0, 0, 0.0, 0.0, {}};
+    
+    if (rows == 0 || cols == 0 || aperture.size() != rows * cols ||
+        apertureSpacing <= 0.0 || wavelength <= 0.0) return pattern;
+    
+    size_t factor = std::max<size_t>(paddingFactor, 1);
+    size_t paddedRows = analyzer_.nextPowerOfTwo(rows * factor);
+    size_t paddedCols = analyzer_.nextPowerOfTwo(cols * factor);
+    
+    std::vector<Complex> field(paddedRows * paddedCols, Complex(0.0, 0.0));
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            field[r * paddedCols + c] = Complex(aperture[r * cols + c], 0.0);
+        }
+    }
+    
+    auto spectrum = analyzer_.fft2D(field, paddedRows, paddedCols);
+    
+    pattern.rows = paddedRows;
+    pattern.cols = paddedCols;
+    pattern.spacingX = wavelength * screenDistance / (paddedCols * apertureSpacing);
+    pattern.spacingY = wavelength * screenDistance / (paddedRows * apertureSpacing);
+    pattern.intensity.resize(paddedRows * paddedCols);
+    
+    // Store with the zero frequency in the center (fftshift)
+    double maxIntensity = 0.0;
+    for (size_t r = 0; r < paddedRows; ++r) {
+        size_t srcRow = (r + paddedRows / 2) % paddedRows;
+        for (size_t c = 0; c < paddedCols; ++c) {
+            size_t srcCol = (c + paddedCols / 2) % paddedCols;
+            const Complex& value = spectrum[srcRow * paddedCols + srcCol];
+            double intensity = value.real * value.real + value.imag * value.imag;
+            
+            pattern.intensity[r * paddedCols + c] = intensity;
+            maxIntensity = std::max(maxIntensity, intensity);
+        }
+    }
+    
+    if (maxIntensity > 0.0) {
+        for (double& value : pattern.intensity) {
+            value /= maxIntensity;
+        }
+    }
+    
+    return pattern;
+}
+
+std::vector<double> DiffractionCalculator::createGratingAperture(
+    int numSlits,
+    double slitWidth,
+    double slitSeparation,
+    double apertureSpacing,
+    size_t numSamples) {
+    
+    std::vector<double> aperture(numSamples, 0.0);
+    
+    double center = (numSamples - 1) / 2.0;
+    double halfWidth = slitWidth / 2.0;
+    
+    for (int slit = 0; slit < numSlits; ++slit) {
+        double slitCenter = (slit - (numSlits - 1) / 2.0) * slitSeparation;
+        
+        for (size_t i = 0; i < numSamples; ++i) {
+            double x = (i - center) * apertureSpacing;
+            if (std::abs(x - slitCenter) <= halfWidth) {
+                aperture[i] = 1.0;
+            }
+        }
+    }
+    
+    return aperture;
+}
+
+std::vector<double> DiffractionCalculator::createRectangularAperture2D(
+    double width,
+    double height,
+    double apertureSpacing,
+    size_t rows,
+    size_t cols) {
+    
+    std::vector<double> aperture(rows * cols, 0.0);
+    
+    double centerRow = (rows - 1) / 2.0;
+    double centerCol = (cols - 1) / 2.0;
+    
+    for (size_t r = 0; r < rows; ++r) {
+        double y = (r - centerRow) * apertureSpacing;
+        if (std::abs(y) > height / 2.0) continue;
+        
+        for (size_t c = 0; c < cols; ++c) {
+            double x = (c - centerCol) * apertureSpacing;
+            if (std::abs(x) <= width / 2.0) {
+                aperture[r * cols + c] = 1.0;
+            }
+        }
+    }
+    
+    return aperture;
+}
+
+std::vector<double> DiffractionCalculator::createCircularAperture2D(
+    double radius,
+    double apertureSpacing,
+    size_t rows,
+    size_t cols) {
+    
+    std::vector<double> aperture(rows * cols, 0.0);
+    
+    double centerRow = (rows - 1) / 2.0;
+    double centerCol = (cols - 1) / 2.0;
+    double radiusSquared = radius * radius;
+    
+    for (size_t r = 0; r < rows; ++r) {
+        double y = (r - centerRow) * apertureSpacing;
+        for (size_t c = 0; c < cols; ++c) {
+            double x = (c - centerCol) * apertureSpacing;
+            if (x * x + y * y <= radiusSquared) {
+                aperture[r * cols + c] = 1.0;
+            }
+        }
+    }
+    
+    return aperture;
+}
+
+void DiffractionCalculator::applyGaussianApodization(std::vector<double>& aperture, double sigma, double apertureSpacing) {
+    if (sigma <= 0.0) return;
+    
+    double center = (aperture.size() - 1) / 2.0;
+    
+    for (size_t i = 0; i < aperture.size(); ++i) {
+        double x = (i - center) * apertureSpacing;
+        aperture[i] *= std::exp(-x * x / (2.0 * sigma * sigma));
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef DIFFRACTION_CALCULATOR_H
+#define DIFFRACTION_CALCULATOR_H
+
+#include "FourierAnalyzer.h"
+#include <vector>
+
+// Far-field (Fraunhofer) pattern of a 1D aperture
+struct DiffractionPattern {
+    std::vector<double> positions;   // Screen positions (same units as screenDistance)
+    std::vector<double> intensity;   // Normalized to the brightest point
+};
+
+// Far-field pattern of a 2D aperture, row-major, centered on the optical axis
+struct DiffractionPattern2D {
+    size_t rows;
+    size_t cols;
+    double spacingX;                 // Screen sample spacing along columns (small-angle)
+    double spacingY;                 // Screen sample spacing along rows (small-angle)
+    std::vector<double> intensity;   // Normalized to the brightest point
+};
+
+class DiffractionCalculator {
+public:
+    DiffractionCalculator() = default;
+    ~DiffractionCalculator() = default;
+
+    // Fraunhofer diffraction of an arbitrary transmission mask sampled every
+    // apertureSpacing. The mask is zero-padded by paddingFactor (rounded up to a
+    // power of two) before the FFT; larger factors give finer screen sampling.
+    DiffractionPattern calculateFraunhoferPattern(
+        const std::vector<double>& aperture,
+        double apertureSpacing,
+        double wavelength,
+        double screenDistance,
+        size_t paddingFactor = 4
+    );
+
+    DiffractionPattern2D calculateFraunhoferPattern2D(
+        const std::vector<double>& aperture,
+        size_t rows,
+        size_t cols,
+        double apertureSpacing,
+        double wavelength,
+        double screenDistance,
+        size_t paddingFactor = 2
+    );
+
+    // Aperture builders
+    std::vector<double> createGratingAperture(
+        int numSlits,
+        double slitWidth,
+        double slitSeparation,
+        double apertureSpacing,
+        size_t numSamples
+    );
+
+    std::vector<double> createRectangularAperture2D(
+        double width,
+        double height,
+        double apertureSpacing,
+        size_t rows,
+        size_t cols
+    );
+
+    std::vector<double> createCircularAperture2D(
+        double radius,
+        double apertureSpacing,
+        size_t rows,
+        size_t cols
+    );
+
+    // Multiply a 1D mask by a centered Gaussian profile (sigma in aperture units)
+    void applyGaussianApodization(std::vector<double>& aperture, double sigma, double apertureSpacing);
+
+private:
+    FourierAnalyzer analyzer_;
+};
+
+#endif // DIFFRACTION_CALCULATOR_H
@@ -18,6 +18,14 @@ std::vector<Complex> FourierAnalyzer::fft(const std::vector<double>& signal) {
     return fftRecursive(complexSignal);
 }
 
+std::vector<Complex> FourierAnalyzer::fft(const std::vector<Complex>& signal) {
+    // Pad to next power of 2
+    std::vector<Complex> padded = signal;
+    padded.resize(nextPowerOfTwo(signal.size()), Complex(0.0, 0.0));
+    
+    return fftRecursive(padded);
+}
+
 std::vector<Complex> FourierAnalyzer::ifft(const std::vector<Complex>& spectrum) {
     // Conjugate the spectrum
     std::vector<Complex> conjugated;
@@ -39,6 +47,56 @@ std::vector<Complex> FourierAnalyzer::ifft(const std::vector<Complex>& spectrum)
     return result;
 }
 
+std::vector<Complex> FourierAnalyzer::fft2D(const std::vector<Complex>& data, size_t rows, size_t cols) {
+    if (rows == 0 || cols == 0 || data.size() != rows * cols) return {};
+    if (nextPowerOfTwo(rows) != rows || nextPowerOfTwo(cols) != cols) return {};
+    
+    // One plan per dimension, shared by every row or column
+    FFTPlan rowPlan, columnPlan;
+    preparePlan(rowPlan, cols);
+    preparePlan(columnPlan, rows);
+    
+    std::vector<Complex> result = data;
+    
+    // Rows are contiguous and transform in place
+    for (size_t r = 0; r < rows; ++r) {
+        fftInPlace(rowPlan, result.data() + r * cols);
+    }
+    
+    // Columns are gathered into one reused line buffer
+    std::vector<Complex> line(rows);
+    for (size_t c = 0; c < cols; ++c) {
+        for (size_t r = 0; r < rows; ++r) {
+            line[r] = result[r * cols + c];
+        }
+        fftInPlace(columnPlan, line.data());
+        for (size_t r = 0; r < rows; ++r) {
+            result[r * cols + c] = line[r];
+        }
+    }
+    
+    return result;
+}
+
+std::vector<Complex> FourierAnalyzer::ifft2D(const std::vector<Complex>& spectrum, size_t rows, size_t cols) {
+    // Conjugate, forward transform, conjugate and normalize
+    std::vector<Complex> conjugated;
+    conjugated.reserve(spectrum.size());
+    for (const auto& c : spectrum) {
+        conjugated.emplace_back(c.real, -c.imag);
+    }
+    
+    auto result = fft2D(conjugated, rows, cols);
+    
+    double n = static_cast<double>(result.size());
+    for (auto& c : result) {
+        c.real = c.real / n;
+        c.imag = -c.imag / n;
+    }
+    
+    return result;
+}
+
 std::vector<Complex> FourierAnalyzer::fftRecursive(const std::vector<Complex>& x) {
     size_t n = x.size();
     if (n <= 1) return x;
@@ -70,6 +128,95 @@ std::vector<Complex> FourierAnalyzer::fftRecursive(const std::vector<Complex>& x
     return result;
 }
 
+bool FourierAnalyzer::preparePlan(FFTPlan& plan, size_t size) {
+    if (size == 0 || nextPowerOfTwo(size) != size) return false;
+    if (plan.size == size) return true;
+    
+    plan.size = size;
+    plan.bitReverse.resize(size);
+    plan.twiddles.resize(size / 2);
+    plan.realTwiddles.resize(size);
+    
+    size_t bits = 0;
+    while ((size_t(1) << bits) < size) ++bits;
+    
+    for (size_t i = 0; i < size; ++i) {
+        size_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        plan.bitReverse[i] = reversed;
+    }
+    
+    for (size_t k = 0; k < plan.twiddles.size(); ++k) {
+        double angle = -Physics::TWO_PI * k / size;
+        plan.twiddles[k] = Complex(std::cos(angle), std::sin(angle));
+    }
+    
+    for (size_t k = 0; k < plan.realTwiddles.size(); ++k) {
+        double angle = -Physics::PI * k / size;
+        plan.realTwiddles[k] = Complex(std::cos(angle), std::sin(angle));
+    }
+    
+    return true;
+}
+
+void FourierAnalyzer::fftInPlace(const FFTPlan& plan, Complex* data) const {
+    size_t n = plan.size;
+    
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = plan.bitReverse[i];
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    
+    // Iterative radix-2 butterflies
+    for (size_t length = 2; length <= n; length <<= 1) {
+        size_t half = length / 2;
+        size_t stride = n / length;
+        
+        for (size_t start = 0; start < n; start += length) {
+            for (size_t k = 0; k < half; ++k) {
+                Complex t = plan.twiddles[k * stride] * data[start + k + half];
+                Complex u = data[start + k];
+                data[start + k] = u + t;
+                data[start + k + half] = u - t;
+            }
+        }
+    }
+}
+
+void FourierAnalyzer::realFFT(const FFTPlan& plan, const double* input, Complex* output) const {
+    size_t m = plan.size;
+    if (m == 0) return;
+    
+    // Pack even samples as real and odd samples as imaginary parts, then
+    // transform at half length
+    for (size_t k = 0; k < m; ++k) {
+        output[k] = Complex(input[2 * k], input[2 * k + 1]);
+    }
+    fftInPlace(plan, output);
+    
+    // Split Z into the spectra of the even (E) and odd (O) samples:
+    // X[k] = E[k] + e^(-2πik/2m) O[k], computed pairwise so it runs in place
+    Complex z0 = output[0];
+    output[0] = Complex(z0.real + z0.imag, 0.0);
+    output[m] = Complex(z0.real - z0.imag, 0.0);
+    
+    for (size_t k = 1; k <= m / 2; ++k) {
+        Complex a = output[k];
+        Complex b = output[m - k];
+        
+        auto combine = [](const Complex& zk, const Complex& zmk, const Complex& w) {
+            Complex even((zk.real + zmk.real) * 0.5, (zk.imag - zmk.imag) * 0.5);
+            Complex odd((zk.imag + zmk.imag) * 0.5, -(zk.real - zmk.real) * 0.5);
+            return even + w * odd;
+        };
+        
+        output[k] = combine(a, b, plan.realTwiddles[k]);
+        output[m - k] = combine(b, a, plan.realTwiddles[m - k]);
+    }
+}
+
 size_t FourierAnalyzer::nextPowerOfTwo(size_t n) {
     if (n <= 1) return 1;
     size_t power = 1;
@@ -80,12 +227,16 @@ size_t FourierAnalyzer::nextPowerOfTwo(size_t n) {
 }
 
 FrequencySpectrum FourierAnalyzer::getSpectrum(const std::vector<double>& signal, double sampleRate) {
+    return getSpectrum(signal.data(), signal.size(), sampleRate);
+}
+
+FrequencySpectrum FourierAnalyzer::getSpectrum(const double* signal, size_t size, double sampleRate) {
     FrequencySpectrum spectrum;
     
-    if (signal.empty()) return spectrum;
+    if (size == 0) return spectrum;
     
     // Apply windowing
-    std::vector<double> windowedSignal = signal;
+    std::vector<double> windowedSignal(signal, signal + size);
     applyWindow(windowedSignal, "hanning");
     
     // Compute FFT
@@ -53,6 +53,16 @@ struct FrequencySpectrum {
     std::vector<Harmonic> harmonics;
 };
 
+// Bit-reversal and twiddle tables for one power-of-two transform size. Built
+// once with FourierAnalyzer::preparePlan and reused, so repeated transforms of
+// the same size allocate nothing.
+struct FFTPlan {
+    size_t size = 0;                    // Complex transform length
+    std::vector<size_t> bitReverse;
+    std::vector<Complex> twiddles;      // e^(-2πik/size), k < size/2
+    std::vector<Complex> realTwiddles;  // e^(-2πik/(2·size)), k < size
+};
+
 class FourierAnalyzer {
 public:
     FourierAnalyzer() = default;
@@ -60,10 +70,23 @@ public:
     
     // FFT implementation
     std::vector<Complex> fft(const std::vector<double>& signal);
+    std::vector<Complex> fft(const std::vector<Complex>& signal);
     std::vector<Complex> ifft(const std::vector<Complex>& spectrum);
     
+    // 2D FFT on row-major data; rows and cols must be powers of two
+    std::vector<Complex> fft2D(const std::vector<Complex>& data, size_t rows, size_t cols);
+    std::vector<Complex> ifft2D(const std::vector<Complex>& spectrum, size_t rows, size_t cols);
+    
+    // Plan-based transforms, in place on caller-owned buffers
+    bool preparePlan(FFTPlan& plan, size_t size);
+    void fftInPlace(const FFTPlan& plan, Complex* data) const;
+    // Transforms 2 * plan.size real samples into plan.size + 1 bins (DC to Nyquist)
+    void realFFT(const FFTPlan& plan, const double* input, Complex* output) const;
+    
     // Spectrum analysis
     FrequencySpectrum getSpectrum(const std::vector<double>& signal, double sampleRate);
+    // Same, for samples the caller does not own (e.g. a mapped SignalFile column)
+    FrequencySpectrum getSpectrum(const double* signal, size_t size, double sampleRate);
     std::vector<Harmonic> findHarmonics(const FrequencySpectrum& spectrum, double threshold = 0.1);
     
     // Filtering
@@ -75,11 +98,11 @@ public:
     double findDominantFrequency(const FrequencySpectrum& spectrum);
     double calculateTHD(const std::vector<Harmonic>& harmonics); // Total Harmonic Distortion
     std::vector<double> getFrequencyAxis(size_t fftSize, double sampleRate);
+    size_t nextPowerOfTwo(size_t n);
     
 private:
     // Helper functions
     std::vector<Complex> fftRecursive(const std::vector<Complex>& x);
-    size_t nextPowerOfTwo(size_t n);
     void applyWindow(std::vector<double>& signal, const std::string& windowType = "hanning");
 };
 
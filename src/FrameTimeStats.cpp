@@ -0,0 +1,66 @@
+#include "FrameTimeStats.h"
+#include <algorithm>
+#include <cmath>
+
+FrameTimeStats::FrameTimeStats(size_t capacity, double binWidthMs, size_t numBins)
+    : samples_(std::max<size_t>(capacity, 1), 0.0)
+    , next_(0)
+    , count_(0)
+    , sum_(0.0)
+    , histogram_(std::max<size_t>(numBins, 1), 0)
+    , binWidth_(binWidthMs > 0.0 ? binWidthMs : 1.0) {}
+
+void FrameTimeStats::record(double milliseconds) {
+    milliseconds = std::max(milliseconds, 0.0);
+
+    // Retire the sample being overwritten
+    if (count_ == samples_.size()) {
+        double oldest = samples_[next_];
+        sum_ -= oldest;
+        --histogram_[binOf(oldest)];
+    } else {
+        ++count_;
+    }
+
+    samples_[next_] = milliseconds;
+    sum_ += milliseconds;
+    ++histogram_[binOf(milliseconds)];
+    next_ = (next_ + 1) % samples_.size();
+}
+
+void FrameTimeStats::clear() {
+    std::fill(histogram_.begin(), histogram_.end(), 0);
+    next_ = 0;
+    count_ = 0;
+    sum_ = 0.0;
+}
+
+double FrameTimeStats::getLatest() const {
+    if (count_ == 0) return 0.0;
+    return samples_[(next_ + samples_.size() - 1) % samples_.size()];
+}
+
+double FrameTimeStats::getMax() const {
+    if (count_ == 0) return 0.0;
+
+    double maxValue = 0.0;
+    for (size_t i = 0; i < count_; ++i) {
+        maxValue = std::max(maxValue, samples_[i]);
+    }
+    return maxValue;
+}
+
+double FrameTimeStats::getPercentile(double fraction) const {
+    if (count_ == 0) return 0.0;
+
+    // Once full the ring holds exactly the window, so its order does not matter
+    scratch_.assign(samples_.begin(), samples_.begin() + count_);
+    size_t rank = static_cast<size_t>(std::clamp(fraction, 0.0, 1.0) * (count_ - 1));
+    std::nth_element(scratch_.begin(), scratch_.begin() + rank, scratch_.end());
+    return scratch_[rank];
+}
+
+size_t FrameTimeStats::binOf(double milliseconds) const {
+    size_t bin = static_cast<size_t>(milliseconds / binWidth_);
+    return std::min(bin, histogram_.size() - 1);
+}
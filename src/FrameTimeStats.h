@@ -0,0 +1,39 @@
+#ifndef FRAME_TIME_STATS_H
+#define FRAME_TIME_STATS_H
+
+#include <vector>
+#include <cstddef>
+
+// Rolling statistics for one timing channel (frame interval, generation,
+// paint): the last `capacity` samples in milliseconds plus a fixed-width
+// histogram over them. The last bin also counts everything beyond the range.
+class FrameTimeStats {
+public:
+    FrameTimeStats(size_t capacity = 240, double binWidthMs = 1.0, size_t numBins = 40);
+    ~FrameTimeStats() = default;
+
+    void record(double milliseconds);
+    void clear();
+
+    size_t getCount() const { return count_; }
+    double getLatest() const;
+    double getMean() const { return count_ > 0 ? sum_ / count_ : 0.0; }
+    double getMax() const;
+    double getPercentile(double fraction) const;
+
+    const std::vector<size_t>& getHistogram() const { return histogram_; }
+    double getBinWidth() const { return binWidth_; }
+
+private:
+    size_t binOf(double milliseconds) const;
+
+    std::vector<double> samples_;    // Ring of the most recent samples
+    size_t next_;
+    size_t count_;
+    double sum_;
+    std::vector<size_t> histogram_;
+    double binWidth_;
+    mutable std::vector<double> scratch_;
+};
+
+#endif // FRAME_TIME_STATS_H
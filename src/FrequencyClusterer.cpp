@@ -0,0 +1,89 @@
+#include "FrequencyClusterer.h"
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+
+FrequencyAnalysis FrequencyClusterer::analyze(
+    const std::vector<double>& frequencies,
+    double tolerance,
+    double maxBeatFrequency,
+    int maxHarmonicOrder) const {
+
+    FrequencyAnalysis analysis;
+    analysis.closestSpacing = 0.0;
+
+    cluster(frequencies, tolerance, analysis);
+    findBeatPairs(maxBeatFrequency, analysis);
+    findHarmonics(tolerance, maxHarmonicOrder, analysis);
+
+    return analysis;
+}
+
+void FrequencyClusterer::cluster(const std::vector<double>& frequencies, double tolerance, FrequencyAnalysis& analysis) const {
+    if (frequencies.empty()) return;
+
+    std::vector<size_t> order(frequencies.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+        [&](size_t a, size_t b) { return frequencies[a] < frequencies[b]; });
+
+    // Any pair within the tolerance is linked through adjacent sorted gaps
+    FrequencyCluster current = {0.0, frequencies[order[0]], frequencies[order[0]], {order[0]}};
+    double sum = frequencies[order[0]];
+
+    for (size_t i = 1; i < order.size(); ++i) {
+        double frequency = frequencies[order[i]];
+        double gap = frequency - frequencies[order[i - 1]];
+
+        if (gap > 0.0 && (analysis.closestSpacing == 0.0 || gap < analysis.closestSpacing)) {
+            analysis.closestSpacing = gap;
+        }
+
+        if (gap <= tolerance) {
+            current.waveIndices.push_back(order[i]);
+            current.maxFrequency = frequency;
+            sum += frequency;
+        } else {
+            current.centerFrequency = sum / current.waveIndices.size();
+            analysis.clusters.push_back(std::move(current));
+            current = {0.0, frequency, frequency, {order[i]}};
+            sum = frequency;
+        }
+    }
+
+    current.centerFrequency = sum / current.waveIndices.size();
+    analysis.clusters.push_back(std::move(current));
+}
+
+void FrequencyClusterer::findBeatPairs(double maxBeatFrequency, FrequencyAnalysis& analysis) const {
+    const auto& clusters = analysis.clusters;
+
+    for (size_t i = 1; i < clusters.size(); ++i) {
+        double beat = clusters[i].centerFrequency - clusters[i - 1].centerFrequency;
+        if (beat > 0.0 && beat < maxBeatFrequency) {
+            analysis.beatPairs.push_back({i - 1, i, beat});
+        }
+    }
+}
+
+void FrequencyClusterer::findHarmonics(double tolerance, int maxHarmonicOrder, FrequencyAnalysis& analysis) const {
+    const auto& clusters = analysis.clusters;
+
+    // Binary search for each multiple: O(clusters * orders * log(clusters))
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        double fundamental = clusters[i].centerFrequency;
+        if (fundamental <= 0.0) continue;
+
+        for (int order = 2; order <= maxHarmonicOrder; ++order) {
+            double target = order * fundamental;
+            double window = tolerance * order;
+
+            auto it = std::lower_bound(clusters.begin() + i + 1, clusters.end(), target - window,
+                [](const FrequencyCluster& cluster, double value) { return cluster.centerFrequency < value; });
+
+            if (it != clusters.end() && std::abs(it->centerFrequency - target) <= window) {
+                analysis.harmonics.push_back({i, static_cast<size_t>(it - clusters.begin()), order});
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef FREQUENCY_CLUSTERER_H
+#define FREQUENCY_CLUSTERER_H
+
+#include <vector>
+#include <cstddef>
+
+// Waves whose sorted frequencies are chained by gaps within the tolerance
+struct FrequencyCluster {
+    double centerFrequency;
+    double minFrequency;
+    double maxFrequency;
+    std::vector<size_t> waveIndices;
+};
+
+// Neighbouring clusters close enough to beat audibly
+struct BeatPair {
+    size_t lowerCluster;
+    size_t upperCluster;
+    double beatFrequency;
+};
+
+// Cluster whose center is an integer multiple of another cluster's center
+struct HarmonicRelation {
+    size_t fundamentalCluster;
+    size_t harmonicCluster;
+    int order;
+};
+
+struct FrequencyAnalysis {
+    std::vector<FrequencyCluster> clusters;   // Sorted by frequency
+    std::vector<BeatPair> beatPairs;
+    std::vector<HarmonicRelation> harmonics;
+    double closestSpacing;                    // Smallest non-zero gap, 0 if none
+
+    bool hasResonance() const {
+        for (const auto& cluster : clusters) {
+            if (cluster.waveIndices.size() > 1) return true;
+        }
+        return false;
+    }
+};
+
+// Sort-based frequency clustering, O(n log n). Stateless, so one instance
+// can be shared between threads.
+class FrequencyClusterer {
+public:
+    FrequencyClusterer() = default;
+    ~FrequencyClusterer() = default;
+
+    FrequencyAnalysis analyze(
+        const std::vector<double>& frequencies,
+        double tolerance = 0.01,
+        double maxBeatFrequency = 2.0,
+        int maxHarmonicOrder = 10
+    ) const;
+
+private:
+    void cluster(const std::vector<double>& frequencies, double tolerance, FrequencyAnalysis& analysis) const;
+    void findBeatPairs(double maxBeatFrequency, FrequencyAnalysis& analysis) const;
+    void findHarmonics(double tolerance, int maxHarmonicOrder, FrequencyAnalysis& analysis) const;
+};
+
+#endif // FREQUENCY_CLUSTERER_H
@@ -0,0 +1,151 @@
+#include "FresnelPropagator.h"
+#include "PhysicsConstants.h"
+#include <cmath>
+#include <algorithm>
+
+FresnelPropagator::FresnelPropagator(size_t maxCachedTransfers)
+    : maxCachedTransfers_(std::max<size_t>(maxCachedTransfers, 1)) {}
+
+OpticalField FresnelPropagator::propagate(
+    const OpticalField& field,
+    double wavelength,
+    double distance,
+    PropagationMethod method) {
+
+    if (!isValidGrid(field) || wavelength <= 0.0) return {0, 0, field.spacing, {}};
+
+    auto spectrum = analyzer_.fft2D(field.values, field.rows, field.cols);
+    const auto& transfer = getTransferFunction(method, wavelength, distance, field.rows, field.cols, field.spacing);
+
+    return applyTransfer(spectrum, field, transfer);
+}
+
+std::vector<OpticalField> FresnelPropagator::propagateSweep(
+    const OpticalField& field,
+    double wavelength,
+    const std::vector<double>& distances,
+    PropagationMethod method) {
+
+    std::vector<OpticalField> planes;
+
+    if (!isValidGrid(field) || wavelength <= 0.0) return planes;
+
+    // The input spectrum does not depend on the distance
+    auto spectrum = analyzer_.fft2D(field.values, field.rows, field.cols);
+
+    planes.reserve(distances.size());
+    for (double distance : distances) {
+        const auto& transfer = getTransferFunction(method, wavelength, distance, field.rows, field.cols, field.spacing);
+        planes.push_back(applyTransfer(spectrum, field, transfer));
+    }
+
+    return planes;
+}
+
+std::vector<double> FresnelPropagator::calculateIntensity(const OpticalField& field) const {
+    std::vector<double> intensity;
+    intensity.reserve(field.values.size());
+
+    for (const auto& value : field.values) {
+        intensity.push_back(value.real * value.real + value.imag * value.imag);
+    }
+
+    return intensity;
+}
+
+OpticalField FresnelPropagator::createField(const std::vector<double>& aperture, size_t rows, size_t cols, double spacing) const {
+    OpticalField field = {rows, cols, spacing, {}};
+
+    field.values.reserve(aperture.size());
+    for (double transmission : aperture) {
+        field.values.emplace_back(transmission, 0.0);
+    }
+
+    return field;
+}
+
+void FresnelPropagator::clearCache() {
+    cache_.clear();
+    cacheOrder_.clear();
+}
+
+const std::vector<Complex>& FresnelPropagator::getTransferFunction(
+    PropagationMethod method,
+    double wavelength,
+    double distance,
+    size_t rows,
+    size_t cols,
+    double spacing) {
+
+    TransferKey key(static_cast<int>(method), wavelength, distance, rows, cols, spacing);
+
+    auto it = cache_.find(key);
+    if (it != cache_.end()) return it->second;
+
+    // Evict the oldest entry once the cache is full
+    if (cache_.size() >= maxCachedTransfers_) {
+        cache_.erase(cacheOrder_.front());
+        cacheOrder_.pop_front();
+    }
+
+    std::vector<Complex> transfer(rows * cols);
+
+    double invWavelengthSquared = 1.0 / (wavelength * wavelength);
+    double waveNumber = Physics::TWO_PI / wavelength;
+
+    // Spatial frequencies in unshifted FFT order
+    std::vector<double> fx(cols);
+    std::vector<double> fy(rows);
+    for (size_t c = 0; c < cols; ++c) {
+        double k = c < cols / 2 ? static_cast<double>(c) : static_cast<double>(c) - cols;
+        fx[c] = k / (cols * spacing);
+    }
+    for (size_t r = 0; r < rows; ++r) {
+        double k = r < rows / 2 ? static_cast<double>(r) : static_cast<double>(r) - rows;
+        fy[r] = k / (rows * spacing);
+    }
+
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            double radialSquared = fx[c] * fx[c] + fy[r] * fy[r];
+            Complex& h = transfer[r * cols + c];
+
+            if (method == PropagationMethod::ANGULAR_SPECTRUM) {
+                double argument = invWavelengthSquared - radialSquared;
+                if (argument >= 0.0) {
+                    double phase = Physics::TWO_PI * distance * std::sqrt(argument);
+                    h = Complex(std::cos(phase), std::sin(phase));
+                } else {
+                    // Evanescent components decay with distance
+                    h = Complex(std::exp(-Physics::TWO_PI * std::abs(distance) * std::sqrt(-argument)), 0.0);
+                }
+            } else {
+                double phase = waveNumber * distance - Physics::PI * wavelength * distance * radialSquared;
+                h = Complex(std::cos(phase), std::sin(phase));
+            }
+        }
+    }
+
+    cacheOrder_.push_back(key);
+    return cache_.emplace(key, std::move(transfer)).first->second;
+}
+
+OpticalField FresnelPropagator::applyTransfer(
+    const std::vector<Complex>& spectrum,
+    const OpticalField& field,
+    const std::vector<Complex>& transfer) {
+
+    std::vector<Complex> filtered(spectrum.size());
+    for (size_t i = 0; i < spectrum.size(); ++i) {
+        filtered[i] = spectrum[i] * transfer[i];
+    }
+
+    return {field.rows, field.cols, field.spacing, analyzer_.ifft2D(filtered, field.rows, field.cols)};
+}
+
+bool FresnelPropagator::isValidGrid(const OpticalField& field) {
+    return field.rows > 0 && field.cols > 0 &&
+           field.values.size() == field.rows * field.cols &&
+           analyzer_.nextPowerOfTwo(field.rows) == field.rows &&
+           analyzer_.nextPowerOfTwo(field.cols) == field.cols;
+}
@@ -0,0 +1,79 @@
+#ifndef FRESNEL_PROPAGATOR_H
+#define FRESNEL_PROPAGATOR_H
+
+#include "FourierAnalyzer.h"
+#include <vector>
+#include <map>
+#include <deque>
+#include <tuple>
+
+enum class PropagationMethod {
+    ANGULAR_SPECTRUM,   // Exact scalar propagation, valid at any distance
+    FRESNEL_TRANSFER    // Paraxial (Fresnel) transfer function
+};
+
+// Complex scalar field sampled on a square-pixel grid, row-major
+struct OpticalField {
+    size_t rows;
+    size_t cols;
+    double spacing;               // Sample pitch (same units as wavelength)
+    std::vector<Complex> values;
+};
+
+class FresnelPropagator {
+public:
+    FresnelPropagator(size_t maxCachedTransfers = 32);
+    ~FresnelPropagator() = default;
+
+    // Propagate a field by the given distance; rows and cols must be powers of two
+    OpticalField propagate(
+        const OpticalField& field,
+        double wavelength,
+        double distance,
+        PropagationMethod method = PropagationMethod::ANGULAR_SPECTRUM
+    );
+
+    // Propagate to several planes; the input spectrum is computed only once
+    std::vector<OpticalField> propagateSweep(
+        const OpticalField& field,
+        double wavelength,
+        const std::vector<double>& distances,
+        PropagationMethod method = PropagationMethod::ANGULAR_SPECTRUM
+    );
+
+    // Utility functions
+    std::vector<double> calculateIntensity(const OpticalField& field) const;
+    OpticalField createField(const std::vector<double>& aperture, size_t rows, size_t cols, double spacing) const;
+
+    // Transfer function cache
+    void clearCache();
+    size_t getCacheSize() const { return cache_.size(); }
+
+private:
+    // (method, wavelength, distance, rows, cols, spacing)
+    using TransferKey = std::tuple<int, double, double, size_t, size_t, double>;
+
+    const std::vector<Complex>& getTransferFunction(
+        PropagationMethod method,
+        double wavelength,
+        double distance,
+        size_t rows,
+        size_t cols,
+        double spacing
+    );
+
+    OpticalField applyTransfer(
+        const std::vector<Complex>& spectrum,
+        const OpticalField& field,
+        const std::vector<Complex>& transfer
+    );
+
+    bool isValidGrid(const OpticalField& field);
+
+    FourierAnalyzer analyzer_;
+    std::map<TransferKey, std::vector<Complex>> cache_;
+    std::deque<TransferKey> cacheOrder_;  // Insertion order for eviction
+    size_t maxCachedTransfers_;
+};
+
+#endif // FRESNEL_PROPAGATOR_H
@@ -0,0 +1,145 @@
+#include "HeatmapRasterizer.h"
+#include "ParallelFor.h"
+#include <algorithm>
+
+HeatmapRasterizer::HeatmapRasterizer(unsigned int numThreads)
+    : numThreads_(std::max(1u, numThreads ? numThreads : std::thread::hardware_concurrency()))
+    , hasPending_(false)
+    , stop_(false)
+    , colormap_(256, 0)
+    , generation_(0)
+    , frontBlock_(0) {
+    worker_ = std::thread(&HeatmapRasterizer::workerLoop, this);
+}
+
+HeatmapRasterizer::~HeatmapRasterizer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        ++generation_;    // Abandon the pass in progress
+    }
+    condition_.notify_one();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void HeatmapRasterizer::setColormap(const std::vector<uint32_t>& colormap) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!colormap.empty()) colormap_ = colormap;
+}
+
+void HeatmapRasterizer::setReadyCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    readyCallback_ = std::move(callback);
+}
+
+void HeatmapRasterizer::render(const InterferenceField& field, const HeatmapView& view) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.field = field;
+        pending_.view = view;
+        pending_.colormap = colormap_;
+        pending_.generation = ++generation_;
+        hasPending_ = true;    // Replaces any request the worker has not started
+    }
+    condition_.notify_one();
+}
+
+int HeatmapRasterizer::takeImage(std::vector<uint32_t>& pixels, HeatmapView& view) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frontBlock_ == 0) return 0;
+
+    // The caller's old buffer becomes the next front buffer
+    pixels.swap(frontBuffer_);
+    view = frontView_;
+
+    int block = frontBlock_;
+    frontBlock_ = 0;
+    return block;
+}
+
+void HeatmapRasterizer::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return stop_ || hasPending_; });
+            if (stop_) return;
+
+            job = std::move(pending_);
+            hasPending_ = false;
+        }
+
+        if (job.view.width <= 0 || job.view.height <= 0 || job.colormap.size() < 256) continue;
+
+        // Every pixel is written by the first pass, so stale contents are harmless
+        backBuffer_.resize(static_cast<size_t>(job.view.width) * job.view.height);
+
+        int coarserBlock = 0;
+        for (int block = COARSE_BLOCK; block >= 1; block /= 2) {
+            if (!renderPass(job, block, coarserBlock)) break;
+            coarserBlock = block;
+
+            std::function<void()> callback;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (generation_ != job.generation) break;
+
+                frontBuffer_ = backBuffer_;
+                frontView_ = job.view;
+                frontBlock_ = block;
+                callback = readyCallback_;
+            }
+
+            if (callback) callback();
+        }
+    }
+}
+
+bool HeatmapRasterizer::renderPass(const Job& job, int block, int coarserBlock) {
+    int tilesX = (job.view.width + TILE_SIZE - 1) / TILE_SIZE;
+    int tilesY = (job.view.height + TILE_SIZE - 1) / TILE_SIZE;
+
+    parallelFor(static_cast<size_t>(tilesX) * tilesY, numThreads_, [&](size_t tile) {
+        if (generation_ != job.generation) return;
+        renderTile(job, static_cast<int>(tile % tilesX), static_cast<int>(tile / tilesX), block, coarserBlock);
+    });
+
+    return generation_ == job.generation;
+}
+
+void HeatmapRasterizer::renderTile(const Job& job, int tileX, int tileY, int block, int coarserBlock) {
+    const HeatmapView& view = job.view;
+    int x0 = tileX * TILE_SIZE;
+    int y0 = tileY * TILE_SIZE;
+    int x1 = std::min(x0 + TILE_SIZE, view.width);
+    int y1 = std::min(y0 + TILE_SIZE, view.height);
+
+    double pixelWidth = (view.maxX - view.minX) / view.width;
+    double pixelHeight = (view.maxY - view.minY) / view.height;
+    double peak = job.field.getPeakIntensity();
+    double scale = peak > 0.0 ? 255.0 / peak : 0.0;
+
+    // Tiles are a multiple of every block size, so blocks never straddle tiles
+    for (int by = y0; by < y1; by += block) {
+        double y = view.maxY - (by + 0.5) * pixelHeight;
+        int rows = std::min(block, y1 - by);
+
+        for (int bx = x0; bx < x1; bx += block) {
+            // Block origins on the coarser grid already hold their value
+            if (coarserBlock > 0 && bx % coarserBlock == 0 && by % coarserBlock == 0) continue;
+
+            double intensity = job.field.evaluateIntensity(view.minX + (bx + 0.5) * pixelWidth, y);
+            int index = std::min(255, static_cast<int>(intensity * scale));
+            uint32_t color = job.colormap[std::max(0, index)];
+
+            int columns = std::min(block, x1 - bx);
+            for (int row = 0; row < rows; ++row) {
+                uint32_t* pixel = backBuffer_.data() + static_cast<size_t>(by + row) * view.width + bx;
+                std::fill(pixel, pixel + columns, color);
+            }
+        }
+    }
+}
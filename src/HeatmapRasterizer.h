@@ -0,0 +1,94 @@
+#ifndef HEATMAP_RASTERIZER_H
+#define HEATMAP_RASTERIZER_H
+
+#include "InterferenceField.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+// World rectangle mapped onto a width x height pixel grid, top row at maxY
+struct HeatmapView {
+    double minX = 0.0;
+    double maxX = 0.0;
+    double minY = 0.0;
+    double maxY = 0.0;
+    int width = 0;
+    int height = 0;
+
+    bool operator==(const HeatmapView& other) const {
+        return minX == other.minX && maxX == other.maxX && minY == other.minY &&
+               maxY == other.maxY && width == other.width && height == other.height;
+    }
+    bool operator!=(const HeatmapView& other) const { return !(*this == other); }
+};
+
+// Renders the intensity of an InterferenceField into 32-bit pixels through a
+// colormap, on a background thread. Each request is drawn in passes from
+// COARSE_BLOCK-sized blocks down to single pixels; a pass evaluates only the
+// pixels the coarser passes skipped and runs its tiles across all cores. A
+// new request abandons the pass in progress at the next tile.
+class HeatmapRasterizer {
+public:
+    explicit HeatmapRasterizer(unsigned int numThreads = 0);  // 0 = hardware concurrency
+    ~HeatmapRasterizer();
+
+    HeatmapRasterizer(const HeatmapRasterizer&) = delete;
+    HeatmapRasterizer& operator=(const HeatmapRasterizer&) = delete;
+
+    // 256 entries, lowest intensity first
+    void setColormap(const std::vector<uint32_t>& colormap);
+
+    // Called on the render thread whenever a pass has been published
+    void setReadyCallback(std::function<void()> callback);
+
+    void render(const InterferenceField& field, const HeatmapView& view);
+
+    // Swaps the newest published pass into pixels; returns its block size,
+    // or 0 if nothing new was published since the last call
+    int takeImage(std::vector<uint32_t>& pixels, HeatmapView& view);
+
+    static constexpr int COARSE_BLOCK = 8;
+    static constexpr int TILE_SIZE = 64;
+
+private:
+    struct Job {
+        InterferenceField field;
+        HeatmapView view;
+        std::vector<uint32_t> colormap;
+        size_t generation = 0;
+    };
+
+    void workerLoop();
+    bool renderPass(const Job& job, int block, int coarserBlock);
+    void renderTile(const Job& job, int tileX, int tileY, int block, int coarserBlock);
+
+    unsigned int numThreads_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    Job pending_;
+    bool hasPending_;
+    bool stop_;
+    std::vector<uint32_t> colormap_;
+    std::function<void()> readyCallback_;
+
+    // Latest generation requested; tiles of older ones return immediately
+    std::atomic<size_t> generation_;
+
+    // Render thread only
+    std::vector<uint32_t> backBuffer_;
+
+    // Published pass, guarded by mutex_
+    std::vector<uint32_t> frontBuffer_;
+    HeatmapView frontView_;
+    int frontBlock_;
+
+    std::thread worker_;
+};
+
+#endif // HEATMAP_RASTERIZER_H
@@ -0,0 +1,129 @@
+#include "InterferenceAnimator.h"
+#include <cmath>
+#include <algorithm>
+
+InterferenceAnimator::InterferenceAnimator(size_t frameCapacity)
+    : frameCapacity_(std::max<size_t>(frameCapacity, 1))
+    , frameCount_(0)
+    , nextSlot_(0)
+    , numCells_(0)
+    , dx_(0.0)
+    , currentTime_(0.0)
+    , timeStep_(0.0)
+    , framesSinceResync_(0) {}
+
+void InterferenceAnimator::setup(
+    const std::vector<const WaveFunction*>& waves,
+    double timeStep,
+    double velocity,
+    double length,
+    int numCells,
+    int maxHarmonics) {
+
+    PhasorEngine phasors;
+    phasors.addWaves(waves, maxHarmonics);
+    components_ = phasors.getComponents();
+
+    numCells_ = numCells > 0 ? static_cast<size_t>(numCells) : 0;
+    dx_ = numCells > 1 ? length / (numCells - 1) : 0.0;
+
+    waveNumbers_.resize(components_.size());
+    for (size_t j = 0; j < components_.size(); ++j) {
+        waveNumbers_[j] = velocity > 0.0 ? Physics::TWO_PI * components_[j].frequency / velocity : 0.0;
+    }
+
+    phasorRe_.assign(components_.size() * numCells_, 0.0);
+    phasorIm_.assign(components_.size() * numCells_, 0.0);
+    frames_.assign(frameCapacity_ * numCells_, 0.0);
+    frameTimes_.assign(frameCapacity_, 0.0);
+
+    reset(0.0, timeStep);
+}
+
+void InterferenceAnimator::reset(double startTime, double timeStep) {
+    currentTime_ = startTime;
+    timeStep_ = timeStep;
+    frameCount_ = 0;
+    nextSlot_ = 0;
+
+    rotationRe_.resize(components_.size());
+    rotationIm_.resize(components_.size());
+    for (size_t j = 0; j < components_.size(); ++j) {
+        double angle = Physics::TWO_PI * components_[j].frequency * timeStep_;
+        rotationRe_[j] = std::cos(angle);
+        rotationIm_[j] = std::sin(angle);
+    }
+
+    resyncPhasors(currentTime_);
+}
+
+const double* InterferenceAnimator::generateFrame() {
+    if (numCells_ == 0 || frameTimes_.empty()) return nullptr;
+
+    double* frame = frames_.data() + nextSlot_ * numCells_;
+    std::fill(frame, frame + numCells_, 0.0);
+
+    // Emit the current state, then rotate every wave-cell phasor by one step
+    for (size_t j = 0; j < components_.size(); ++j) {
+        double* re = phasorRe_.data() + j * numCells_;
+        double* im = phasorIm_.data() + j * numCells_;
+        double cosStep = rotationRe_[j];
+        double sinStep = rotationIm_[j];
+
+        for (size_t c = 0; c < numCells_; ++c) {
+            frame[c] += im[c];
+
+            double rotatedRe = re[c] * cosStep - im[c] * sinStep;
+            im[c] = re[c] * sinStep + im[c] * cosStep;
+            re[c] = rotatedRe;
+        }
+    }
+
+    frameTimes_[nextSlot_] = currentTime_;
+    nextSlot_ = (nextSlot_ + 1) % frameCapacity_;
+    frameCount_ = std::min(frameCount_ + 1, frameCapacity_);
+
+    currentTime_ += timeStep_;
+    if (++framesSinceResync_ >= RESYNC_INTERVAL) {
+        resyncPhasors(currentTime_);
+    }
+
+    return frame;
+}
+
+void InterferenceAnimator::generateFrames(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        generateFrame();
+    }
+}
+
+const double* InterferenceAnimator::getFrame(size_t index) const {
+    if (index >= frameCount_) return nullptr;
+
+    size_t oldest = (nextSlot_ + frameCapacity_ - frameCount_) % frameCapacity_;
+    return frames_.data() + ((oldest + index) % frameCapacity_) * numCells_;
+}
+
+double InterferenceAnimator::getFrameTime(size_t index) const {
+    if (index >= frameCount_) return 0.0;
+
+    size_t oldest = (nextSlot_ + frameCapacity_ - frameCount_) % frameCapacity_;
+    return frameTimes_[(oldest + index) % frameCapacity_];
+}
+
+void InterferenceAnimator::resyncPhasors(double time) {
+    for (size_t j = 0; j < components_.size(); ++j) {
+        const PhasorComponent& component = components_[j];
+        double temporal = Physics::TWO_PI * component.frequency * time + component.phase;
+        double* re = phasorRe_.data() + j * numCells_;
+        double* im = phasorIm_.data() + j * numCells_;
+
+        for (size_t c = 0; c < numCells_; ++c) {
+            double angle = temporal - waveNumbers_[j] * c * dx_;
+            re[c] = component.amplitude * std::cos(angle);
+            im[c] = component.amplitude * std::sin(angle);
+        }
+    }
+
+    framesSinceResync_ = 0;
+}
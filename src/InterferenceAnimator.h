@@ -0,0 +1,71 @@
+#ifndef INTERFERENCE_ANIMATOR_H
+#define INTERFERENCE_ANIMATOR_H
+
+#include "PhasorEngine.h"
+#include <vector>
+
+// Generates successive spatial frames of y(x,t) = Σ A sin(ωt - kx + φ) by rotating
+// precomputed per-cell phasors, and keeps the most recent frames in a ring buffer
+class InterferenceAnimator {
+public:
+    InterferenceAnimator(size_t frameCapacity = 120);
+    ~InterferenceAnimator() = default;
+
+    // Precompute spatial phasors; k = 2πf / velocity for every component.
+    // The movie starts at t = 0 and advances timeStep per frame
+    void setup(
+        const std::vector<const WaveFunction*>& waves,
+        double timeStep,
+        double velocity = 1.0,
+        double length = 10.0,
+        int numCells = 1000,
+        int maxHarmonics = PhasorEngine::DEFAULT_HARMONICS
+    );
+
+    // Restart the movie at startTime, advancing timeStep per frame
+    void reset(double startTime, double timeStep);
+
+    // Produce the next frame into the ring buffer and return it; nullptr
+    // until setup() has been given at least one cell
+    const double* generateFrame();
+    void generateFrames(size_t count);
+
+    // Playback / export access, index 0 is the oldest frame still held
+    size_t getFrameCount() const { return frameCount_; }
+    size_t getFrameCapacity() const { return frameCapacity_; }
+    size_t getCellCount() const { return numCells_; }
+    const double* getFrame(size_t index) const;
+    double getFrameTime(size_t index) const;
+    double getCurrentTime() const { return currentTime_; }
+
+private:
+    void resyncPhasors(double time);
+
+    // Components and their per-frame rotation e^{iωΔt}
+    std::vector<PhasorComponent> components_;
+    std::vector<double> waveNumbers_;
+    std::vector<double> rotationRe_;
+    std::vector<double> rotationIm_;
+
+    // Spatial phasors, [component][cell], structure-of-arrays
+    std::vector<double> phasorRe_;
+    std::vector<double> phasorIm_;
+
+    // Frame ring buffer, [slot][cell]
+    std::vector<double> frames_;
+    std::vector<double> frameTimes_;
+    size_t frameCapacity_;
+    size_t frameCount_;
+    size_t nextSlot_;
+
+    size_t numCells_;
+    double dx_;
+    double currentTime_;
+    double timeStep_;
+    size_t framesSinceResync_;
+
+    // Phasors are recomputed exactly this often to bound rotation drift
+    static constexpr size_t RESYNC_INTERVAL = 256;
+};
+
+#endif // INTERFERENCE_ANIMATOR_H
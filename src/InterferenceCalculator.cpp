@@ -1,9 +1,76 @@
 #include "InterferenceCalculator.h"
 #include "PhysicsConstants.h"
+#include "PhasorEngine.h"
+#include "ParallelFor.h"
 #include <cmath>
 #include <algorithm>
 #include <sstream>
 
+namespace {
+
+// Brent's method on a bracket [a, b] with f(a) and f(b) of opposite sign
+template <typename Function>
+double brentRoot(Function&& f, double a, double b, double fa, double fb, double tolerance) {
+    constexpr int MAX_ITERATIONS = 100;
+    
+    if (std::abs(fa) < std::abs(fb)) {
+        std::swap(a, b);
+        std::swap(fa, fb);
+    }
+    
+    double c = a;
+    double fc = fa;
+    double d = b - a;
+    bool bisected = true;
+    
+    for (int iter = 0; iter < MAX_ITERATIONS && fb != 0.0 && std::abs(b - a) > tolerance; ++iter) {
+        double s;
+        if (fa != fc && fb != fc) {
+            // Inverse quadratic interpolation
+            s = a * fb * fc / ((fa - fb) * (fa - fc)) +
+                b * fa * fc / ((fb - fa) * (fb - fc)) +
+                c * fa * fb / ((fc - fa) * (fc - fb));
+        } else {
+            // Secant step
+            s = b - fb * (b - a) / (fb - fa);
+        }
+        
+        double lo = (3.0 * a + b) / 4.0;
+        bool outside = (s - lo) * (s - b) > 0.0;
+        bool slow = bisected ? std::abs(s - b) >= std::abs(b - c) / 2.0
+                             : std::abs(s - b) >= std::abs(c - d) / 2.0;
+        bool tiny = bisected ? std::abs(b - c) < tolerance
+                             : std::abs(c - d) < tolerance;
+        
+        bisected = outside || slow || tiny;
+        if (bisected) {
+            s = (a + b) / 2.0;
+        }
+        
+        double fs = f(s);
+        d = c;
+        c = b;
+        fc = fb;
+        
+        if (fa * fs < 0.0) {
+            b = s;
+            fb = fs;
+        } else {
+            a = s;
+            fa = fs;
+        }
+        
+        if (std::abs(fa) < std::abs(fb)) {
+            std::swap(a, b);
+            std::swap(fa, fb);
+        }
+    }
+    
+    return b;
+}
+
+}
+
 InterferenceResult InterferenceCalculator::calculateTwoWaveInterference(
     const WaveFunction& wave1, 
     const WaveFunction& wave2,
@@ -13,27 +80,11 @@ InterferenceResult InterferenceCalculator::calculateTwoWaveInterference(
     
     InterferenceResult result;
     
-    std::vector<double> positions;
-    std::vector<double> amplitudes;
-    positions.reserve(numPoints);
-    amplitudes.reserve(numPoints);
-    
-    double dx = length / (numPoints - 1);
-    
-    // Calculate superposition at each point
-    for (int i = 0; i < numPoints; ++i) {
-        double x = i * dx;
-        double amp1 = wave1.evaluate(x, time);
-        double amp2 = wave2.evaluate(x, time);
-        double totalAmp = amp1 + amp2;
-        
-        positions.push_back(x);
-        amplitudes.push_back(totalAmp);
-    }
-    
-    // Analyze the result
-    auto minmax = std::minmax_element(amplitudes.begin(), amplitudes.end());
-    result.amplitude = std::max(std::abs(*minmax.first), std::abs(*minmax.second));
+    // Sample the superposition once and analyze it in a single pass
+    std::vector<const WaveFunction*> waves = {&wave1, &wave2};
+    std::vector<double>& amplitudes = scratchBuffer();
+    double dx = sampleSuperposition(waves, time, length, numPoints, amplitudes);
+    result.amplitude = analyzeSamples(amplitudes, dx, 0.1, &result.nodePositions, &result.antinodePositions, nullptr);
     
     // Calculate phase shift
     result.phase = calculatePhaseShift(wave1, wave2);
@@ -46,17 +97,6 @@ InterferenceResult InterferenceCalculator::calculateTwoWaveInterference(
     // Calculate beat frequency if applicable
     result.beatFrequency = calculateBeatFrequency(wave1.getFrequency(), wave2.getFrequency());
     
-    // Find nodes and antinodes
-    std::vector<InterferenceNode> nodes = findInterferenceNodes({&wave1, &wave2}, time, length, numPoints);
-    
-    for (const auto& node : nodes) {
-        if (node.type == InterferenceNode::NODE) {
-            result.nodePositions.push_back(node.position);
-        } else {
-            result.antinodePositions.push_back(node.position);
-        }
-    }
-    
     result.description = generateDescription(result);
     
     return result;
@@ -83,40 +123,18 @@ InterferenceResult InterferenceCalculator::calculateMultiWaveInterference(
         return result;
     }
     
-    std::vector<double> amplitudes;
-    amplitudes.reserve(numPoints);
+    // Sample the superposition once and analyze it in a single pass
+    std::vector<double>& amplitudes = scratchBuffer();
+    double dx = sampleSuperposition(waves, time, length, numPoints, amplitudes);
+    result.amplitude = analyzeSamples(amplitudes, dx, 0.1, &result.nodePositions, &result.antinodePositions, nullptr);
     
-    double dx = length / (numPoints - 1);
-    
-    // Calculate superposition at each point
-    for (int i = 0; i < numPoints; ++i) {
-        double x = i * dx;
-        double totalAmp = calculateTotalAmplitude(waves, x, time);
-        amplitudes.push_back(totalAmp);
-    }
-    
-    // Analyze the result
-    auto minmax = std::minmax_element(amplitudes.begin(), amplitudes.end());
-    result.amplitude = std::max(std::abs(*minmax.first), std::abs(*minmax.second));
-    
-    // For multi-wave, we look for beat frequency between dominant waves
-    if (waves.size() >= 2) {
-        result.beatFrequency = calculateBeatFrequency(waves[0]->getFrequency(), waves[1]->getFrequency());
-    }
-    
-    // Find nodes and antinodes
-    std::vector<InterferenceNode> nodes = findInterferenceNodes(waves, time, length, numPoints);
-    
-    for (const auto& node : nodes) {
-        if (node.type == InterferenceNode::NODE) {
-            result.nodePositions.push_back(node.position);
-        } else {
-            result.antinodePositions.push_back(node.position);
-        }
-    }
+    // One clustering pass gives both the beat and the resonance check; the audible
+    // beat comes from the closest pair of distinct frequencies
+    FrequencyAnalysis frequencies = analyzeFrequencies(waves);
+    result.beatFrequency = frequencies.closestSpacing;
     
     // Detect resonance
-    if (detectResonance(waves)) {
+    if (frequencies.hasResonance()) {
         result.type = InterferenceResult::CONSTRUCTIVE;
         result.description = "Resonance detected - constructive interference";
     } else if (result.beatFrequency > 0 && result.beatFrequency < 2.0) {
@@ -134,6 +152,10 @@ double InterferenceCalculator::calculateBeatFrequency(double f1, double f2) {
     return std::abs(f1 - f2);
 }
 
+double InterferenceCalculator::calculateClosestBeatFrequency(const std::vector<const WaveFunction*>& waves) {
+    return analyzeFrequencies(waves).closestSpacing;
+}
+
 double InterferenceCalculator::calculateBeatPeriod(double f1, double f2) {
     double beatFreq = calculateBeatFrequency(f1, f2);
     return beatFreq > 0 ? 1.0 / beatFreq : 0.0;
@@ -145,22 +167,18 @@ std::vector<double> InterferenceCalculator::calculateBeatEnvelope(
     double duration,
     double sampleRate) {
     
-    std::vector<double> envelope;
-    int numSamples = static_cast<int>(duration * sampleRate);
-    envelope.reserve(numSamples);
-    
-    double dt = 1.0 / sampleRate;
-    double beatFreq = calculateBeatFrequency(wave1.getFrequency(), wave2.getFrequency());
-    double avgAmplitude = (wave1.getAmplitude() + wave2.getAmplitude()) / 2.0;
-    double amplitudeDiff = std::abs(wave1.getAmplitude() - wave2.getAmplitude());
-    
-    for (int i = 0; i < numSamples; ++i) {
-        double t = i * dt;
-        double envelopeAmp = avgAmplitude + amplitudeDiff * std::cos(Physics::TWO_PI * beatFreq * t / 2.0);
-        envelope.push_back(std::abs(envelopeAmp));
-    }
+    return calculateBeatEnvelope({&wave1, &wave2}, duration, sampleRate);
+}
+
+std::vector<double> InterferenceCalculator::calculateBeatEnvelope(
+    const std::vector<const WaveFunction*>& waves,
+    double duration,
+    double sampleRate) {
     
-    return envelope;
+    // Exact envelope from the phasor sum; no carrier-rate sampling required
+    PhasorEngine phasors;
+    phasors.addWaves(waves);
+    return phasors.calculateEnvelope(duration, sampleRate);
 }
 
 std::vector<InterferenceNode> InterferenceCalculator::findInterferenceNodes(
@@ -171,37 +189,87 @@ std::vector<InterferenceNode> InterferenceCalculator::findInterferenceNodes(
     double threshold) {
     
     std::vector<InterferenceNode> nodes;
-    std::vector<double> amplitudes;
-    amplitudes.reserve(numPoints);
+    std::vector<double>& amplitudes = scratchBuffer();
     
-    double dx = length / (numPoints - 1);
+    double dx = sampleSuperposition(waves, time, length, numPoints, amplitudes);
+    analyzeSamples(amplitudes, dx, threshold, nullptr, nullptr, &nodes);
     
-    // Calculate total amplitude at each point
-    for (int i = 0; i < numPoints; ++i) {
-        double x = i * dx;
-        double totalAmp = calculateTotalAmplitude(waves, x, time);
-        amplitudes.push_back(std::abs(totalAmp));
-    }
+    return nodes;
+}
+
+std::vector<InterferenceNode> InterferenceCalculator::findInterferenceNodesAdaptive(
+    const std::vector<const WaveFunction*>& waves,
+    double time,
+    double length,
+    int numCoarsePoints,
+    double threshold,
+    double tolerance) {
+    
+    std::vector<InterferenceNode> nodes;
+    std::vector<InterferenceNode> antinodes;
+    
+    if (waves.empty() || numCoarsePoints < 3) return nodes;
     
-    // Find local minima (nodes) and maxima (antinodes)
-    std::vector<double> minima = findLocalExtrema(amplitudes, false);
-    std::vector<double> maxima = findLocalExtrema(amplitudes, true);
+    double dx = length / (numCoarsePoints - 1);
+    double h = dx * 1e-3;  // Central-difference step for the slope
     
-    // Convert indices to positions and filter by threshold
-    for (double minIdx : minima) {
-        int idx = static_cast<int>(minIdx);
-        if (idx >= 0 && idx < numPoints && amplitudes[idx] <= threshold) {
-            nodes.push_back({idx * dx, amplitudes[idx], InterferenceNode::NODE});
+    auto amplitudeAt = [&](double x) { return calculateTotalAmplitude(waves, x, time); };
+    auto slopeAt = [&](double x) { return (amplitudeAt(x + h) - amplitudeAt(x - h)) / (2.0 * h); };
+    
+    // Coarse pass on the signed superposition
+    std::vector<double>& samples = scratchBuffer();
+    samples.resize(numCoarsePoints);
+    for (int i = 0; i < numCoarsePoints; ++i) {
+        samples[i] = amplitudeAt(i * dx);
+    }
+    
+    // Nodes: zero crossings of the superposition
+    for (int i = 0; i + 1 < numCoarsePoints; ++i) {
+        double y0 = samples[i];
+        double y1 = samples[i + 1];
+        
+        if (y0 == 0.0) {
+            nodes.push_back({i * dx, 0.0, InterferenceNode::NODE});
+        } else if (y0 * y1 < 0.0) {
+            double root = brentRoot(amplitudeAt, i * dx, (i + 1) * dx, y0, y1, tolerance);
+            nodes.push_back({root, std::abs(amplitudeAt(root)), InterferenceNode::NODE});
         }
     }
     
-    for (double maxIdx : maxima) {
-        int idx = static_cast<int>(maxIdx);
-        if (idx >= 0 && idx < numPoints && amplitudes[idx] >= threshold) {
-            nodes.push_back({idx * dx, amplitudes[idx], InterferenceNode::ANTINODE});
+    // Extrema of the superposition: maxima of |y| are antinodes, minima of |y|
+    // that do not cross zero are shallow nodes
+    for (int i = 1; i + 1 < numCoarsePoints; ++i) {
+        double slopeLeft = samples[i] - samples[i - 1];
+        double slopeRight = samples[i + 1] - samples[i];
+        bool isMaximum = slopeLeft > 0.0 && slopeRight <= 0.0;
+        bool isMinimum = slopeLeft < 0.0 && slopeRight >= 0.0;
+        
+        if (!isMaximum && !isMinimum) continue;
+        
+        double a = (i - 1) * dx;
+        double b = (i + 1) * dx;
+        double fa = slopeAt(a);
+        double fb = slopeAt(b);
+        
+        // Fall back to the grid point if the slope is not bracketed (e.g. a discontinuity)
+        double position = (fa * fb < 0.0) ? brentRoot(slopeAt, a, b, fa, fb, tolerance) : i * dx;
+        double value = amplitudeAt(position);
+        double magnitude = std::abs(value);
+        
+        bool isAbsMinimum = isMaximum ? (value < 0.0) : (value > 0.0);
+        
+        if (isAbsMinimum && magnitude <= threshold) {
+            nodes.push_back({position, magnitude, InterferenceNode::NODE});
+        } else if (!isAbsMinimum && magnitude >= threshold) {
+            antinodes.push_back({position, magnitude, InterferenceNode::ANTINODE});
         }
     }
     
+    // Same ordering as findInterferenceNodes: nodes and antinodes by position
+    nodes.insert(nodes.end(), antinodes.begin(), antinodes.end());
+    std::sort(nodes.begin(), nodes.end(),
+        [](const InterferenceNode& lhs, const InterferenceNode& rhs) { return lhs.position < rhs.position; });
+    
     return nodes;
 }
 
@@ -261,18 +329,20 @@ bool InterferenceCalculator::detectResonance(
     
     if (waves.size() < 2) return false;
     
-    for (size_t i = 0; i < waves.size(); ++i) {
-        for (size_t j = i + 1; j < waves.size(); ++j) {
-            double freq1 = waves[i]->getFrequency();
-            double freq2 = waves[j]->getFrequency();
-            
-            if (std::abs(freq1 - freq2) <= frequencyTolerance) {
-                return true;
-            }
-        }
+    return analyzeFrequencies(waves, frequencyTolerance).hasResonance();
+}
+
+FrequencyAnalysis InterferenceCalculator::analyzeFrequencies(
+    const std::vector<const WaveFunction*>& waves,
+    double frequencyTolerance) {
+    
+    std::vector<double> frequencies;
+    frequencies.reserve(waves.size());
+    for (const auto* wave : waves) {
+        frequencies.push_back(wave->getFrequency());
     }
     
-    return false;
+    return FrequencyClusterer().analyze(frequencies, frequencyTolerance);
 }
 
 double InterferenceCalculator::calculateResonanceAmplification(
@@ -293,6 +363,201 @@ double InterferenceCalculator::calculateResonanceAmplification(
     return individualSum > 0 ? totalAmplitude / individualSum : 0.0;
 }
 
+std::vector<double> InterferenceCalculator::calculateYoungsDoubleSlitPattern(
+    double wavelength,
+    double slitSeparation,
+    double screenDistance,
+    double screenWidth,
+    int numPoints) {
+    
+    std::vector<double> pattern;
+    if (numPoints < 2 || wavelength <= 0.0) return pattern;
+    
+    pattern.reserve(numPoints);
+    double dy = screenWidth / (numPoints - 1);
+    double phaseScale = Physics::PI * slitSeparation / wavelength;
+    
+    for (int i = 0; i < numPoints; ++i) {
+        double y = -screenWidth / 2.0 + i * dy;
+        double sinTheta = y / std::sqrt(y * y + screenDistance * screenDistance);
+        
+        // I / I0 = cos^2(pi d sin(theta) / lambda)
+        double c = std::cos(phaseScale * sinTheta);
+        pattern.push_back(c * c);
+    }
+    
+    return pattern;
+}
+
+std::vector<double> InterferenceCalculator::calculateSingleSlitDiffraction(
+    double wavelength,
+    double slitWidth,
+    double screenDistance,
+    double screenWidth,
+    int numPoints) {
+    
+    std::vector<double> pattern;
+    if (numPoints < 2 || wavelength <= 0.0) return pattern;
+    
+    pattern.reserve(numPoints);
+    double dy = screenWidth / (numPoints - 1);
+    double phaseScale = Physics::PI * slitWidth / wavelength;
+    
+    for (int i = 0; i < numPoints; ++i) {
+        double y = -screenWidth / 2.0 + i * dy;
+        double sinTheta = y / std::sqrt(y * y + screenDistance * screenDistance);
+        
+        // I / I0 = sinc^2(pi a sin(theta) / lambda)
+        double beta = phaseScale * sinTheta;
+        double sinc = std::abs(beta) < 1e-12 ? 1.0 : std::sin(beta) / beta;
+        pattern.push_back(sinc * sinc);
+    }
+    
+    return pattern;
+}
+
+std::vector<double> InterferenceCalculator::calculatePolychromaticDoubleSlitPattern(
+    const std::vector<SpectralSample>& spectrum,
+    double slitSeparation,
+    double screenDistance,
+    double screenWidth,
+    int numPoints,
+    double slitWidth,
+    unsigned int numThreads) {
+    
+    return integrateSpectrum(spectrum, slitSeparation, slitWidth, screenDistance, screenWidth, numPoints, numThreads);
+}
+
+std::vector<double> InterferenceCalculator::calculatePolychromaticSingleSlitDiffraction(
+    const std::vector<SpectralSample>& spectrum,
+    double slitWidth,
+    double screenDistance,
+    double screenWidth,
+    int numPoints,
+    unsigned int numThreads) {
+    
+    return integrateSpectrum(spectrum, 0.0, slitWidth, screenDistance, screenWidth, numPoints, numThreads);
+}
+
+std::vector<SpectralSample> InterferenceCalculator::createBlackbodySpectrum(
+    double temperature,
+    double minWavelength,
+    double maxWavelength,
+    int numSamples) {
+    
+    std::vector<SpectralSample> spectrum;
+    if (numSamples < 1 || temperature <= 0.0) return spectrum;
+    
+    // Planck's law up to a constant: λ^-5 / (exp(hc / λkT) - 1)
+    constexpr double SECOND_RADIATION_CONSTANT = 1.438776877e-2;  // hc/k in m*K
+    double step = numSamples > 1 ? (maxWavelength - minWavelength) / (numSamples - 1) : 0.0;
+    
+    spectrum.reserve(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        double wavelength = minWavelength + i * step;
+        double weight = 1.0 / (std::pow(wavelength, 5) *
+                               std::expm1(SECOND_RADIATION_CONSTANT / (wavelength * temperature)));
+        spectrum.push_back({wavelength, weight});
+    }
+    
+    return spectrum;
+}
+
+std::vector<SpectralSample> InterferenceCalculator::createGaussianSpectrum(
+    double centerWavelength,
+    double bandwidth,
+    int numSamples) {
+    
+    std::vector<SpectralSample> spectrum;
+    if (numSamples < 1) return spectrum;
+    
+    if (numSamples == 1 || bandwidth <= 0.0) {
+        spectrum.push_back({centerWavelength, 1.0});
+        return spectrum;
+    }
+    
+    // Sample ±3σ around the center
+    double sigma = bandwidth / 2.3548200450309493;
+    spectrum.reserve(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+        double u = -3.0 + 6.0 * i / (numSamples - 1);
+        spectrum.push_back({centerWavelength + u * sigma, std::exp(-0.5 * u * u)});
+    }
+    
+    return spectrum;
+}
+
+std::vector<double> InterferenceCalculator::integrateSpectrum(
+    const std::vector<SpectralSample>& spectrum,
+    double slitSeparation,
+    double slitWidth,
+    double screenDistance,
+    double screenWidth,
+    int numPoints,
+    unsigned int numThreads) {
+    
+    std::vector<double> pattern;
+    if (numPoints < 2 || spectrum.empty()) return pattern;
+    
+    size_t n = static_cast<size_t>(numPoints);
+    pattern.assign(n, 0.0);
+    
+    // Geometry shared by all wavelengths
+    std::vector<double> sinTheta(n);
+    double dy = screenWidth / (numPoints - 1);
+    for (size_t i = 0; i < n; ++i) {
+        double y = -screenWidth / 2.0 + i * dy;
+        sinTheta[i] = y / std::sqrt(y * y + screenDistance * screenDistance);
+    }
+    
+    // Per-wavelength scales in contiguous arrays for the inner accumulation loop
+    size_t m = spectrum.size();
+    std::vector<double> fringeScale(m), envelopeScale(m), weights(m);
+    double totalWeight = 0.0;
+    for (size_t j = 0; j < m; ++j) {
+        double wavelength = spectrum[j].wavelength;
+        fringeScale[j] = wavelength > 0.0 ? Physics::TWO_PI * slitSeparation / wavelength : 0.0;
+        envelopeScale[j] = wavelength > 0.0 ? Physics::PI * slitWidth / wavelength : 0.0;
+        weights[j] = wavelength > 0.0 ? spectrum[j].weight : 0.0;
+        totalWeight += weights[j];
+    }
+    
+    if (totalWeight <= 0.0) return pattern;
+    
+    bool hasFringes = slitSeparation > 0.0;
+    bool hasEnvelope = slitWidth > 0.0;
+    
+    auto evaluateTile = [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            double s = sinTheta[i];
+            double sum = 0.0;
+            
+            for (size_t j = 0; j < m; ++j) {
+                // cos²(x) = (1 + cos 2x) / 2
+                double value = hasFringes ? 0.5 * (1.0 + std::cos(fringeScale[j] * s)) : 1.0;
+                if (hasEnvelope) {
+                    double beta = envelopeScale[j] * s;
+                    double sinc = std::abs(beta) < 1e-12 ? 1.0 : std::sin(beta) / beta;
+                    value *= sinc * sinc;
+                }
+                sum += weights[j] * value;
+            }
+            
+            pattern[i] = sum / totalWeight;
+        }
+    };
+    
+    // Tiles are interleaved across workers so bright and dark regions are balanced
+    constexpr size_t TILE = 256;
+    size_t numTiles = (n + TILE - 1) / TILE;
+    
+    parallelFor(numTiles, numThreads, [&](size_t tile) {
+        evaluateTile(tile * TILE, std::min(n, (tile + 1) * TILE));
+    });
+    
+    return pattern;
+}
+
 double InterferenceCalculator::calculateTotalAmplitude(
     const std::vector<const WaveFunction*>& waves,
     double position,
@@ -323,26 +588,81 @@ InterferenceResult::Type InterferenceCalculator::classifyInterference(
     }
 }
 
-std::vector<double> InterferenceCalculator::findLocalExtrema(const std::vector<double>& data, bool findMaxima) {
-    std::vector<double> extrema;
+std::vector<double>& InterferenceCalculator::scratchBuffer() {
+    // One buffer per thread: reused across calls, never shared between threads
+    thread_local std::vector<double> buffer;
+    return buffer;
+}
+
+double InterferenceCalculator::sampleSuperposition(
+    const std::vector<const WaveFunction*>& waves,
+    double time,
+    double length,
+    int numPoints,
+    std::vector<double>& amplitudes) {
     
-    if (data.size() < 3) return extrema;
+    size_t n = numPoints > 0 ? static_cast<size_t>(numPoints) : 0;
+    double dx = numPoints > 1 ? length / (numPoints - 1) : 0.0;
     
-    for (size_t i = 1; i < data.size() - 1; ++i) {
-        bool isExtremum = false;
-        
-        if (findMaxima) {
-            isExtremum = (data[i] > data[i-1]) && (data[i] > data[i+1]);
-        } else {
-            isExtremum = (data[i] < data[i-1]) && (data[i] < data[i+1]);
+    // Only grows when a larger grid is requested
+    amplitudes.resize(n);
+    double* amps = amplitudes.data();
+    
+    for (size_t i = 0; i < n; ++i) {
+        amps[i] = 0.0;
+    }
+    
+    // Accumulate wave by wave so the inner loop stays on one contiguous array
+    for (const auto* wave : waves) {
+        for (size_t i = 0; i < n; ++i) {
+            amps[i] += wave->evaluate(i * dx, time);
         }
+    }
+    
+    for (size_t i = 0; i < n; ++i) {
+        amps[i] = std::abs(amps[i]);
+    }
+    
+    return dx;
+}
+
+double InterferenceCalculator::analyzeSamples(
+    const std::vector<double>& amplitudes,
+    double dx,
+    double threshold,
+    std::vector<double>* nodePositions,
+    std::vector<double>* antinodePositions,
+    std::vector<InterferenceNode>* nodes) {
+    
+    const double* amps = amplitudes.data();
+    size_t n = amplitudes.size();
+    
+    if (n == 0) return 0.0;
+    
+    double peak = std::max(amps[0], amps[n - 1]);
+    
+    // Single pass: track the peak and classify interior points as minima or maxima.
+    // The comparisons are branch-free; only the (rare) hits take a branch.
+    for (size_t i = 1; i + 1 < n; ++i) {
+        double left = amps[i - 1];
+        double center = amps[i];
+        double right = amps[i + 1];
+        
+        peak = std::max(peak, center);
+        
+        bool isNode = (center < left) & (center < right) & (center <= threshold);
+        bool isAntinode = (center > left) & (center > right) & (center >= threshold);
         
-        if (isExtremum) {
-            extrema.push_back(static_cast<double>(i));
+        if (isNode) {
+            if (nodePositions) nodePositions->push_back(i * dx);
+            if (nodes) nodes->push_back({i * dx, center, InterferenceNode::NODE});
+        } else if (isAntinode) {
+            if (antinodePositions) antinodePositions->push_back(i * dx);
+            if (nodes) nodes->push_back({i * dx, center, InterferenceNode::ANTINODE});
         }
     }
     
-    return extrema;
+    return peak;
 }
 
 double InterferenceCalculator::calculateRMSAmplitude(const std::vector<double>& data) {
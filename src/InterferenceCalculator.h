@@ -2,6 +2,7 @@
 #define INTERFERENCE_CALCULATOR_H
 
 #include "WaveFunction.h"
+#include "FrequencyClusterer.h"
 #include <vector>
 
 struct InterferenceResult {
@@ -21,6 +22,12 @@ struct InterferenceResult {
     std::string description;
 };
 
+// One line of a discretized source spectrum
+struct SpectralSample {
+    double wavelength;
+    double weight;
+};
+
 struct InterferenceNode {
     double position;
     double amplitude;
@@ -55,14 +62,20 @@ public:
     // Beat phenomena
     double calculateBeatFrequency(double f1, double f2);
     double calculateBeatPeriod(double f1, double f2);
+    double calculateClosestBeatFrequency(const std::vector<const WaveFunction*>& waves);
     std::vector<double> calculateBeatEnvelope(
         const WaveFunction& wave1,
         const WaveFunction& wave2,
         double duration = 10.0,
         double sampleRate = 100.0
     );
+    std::vector<double> calculateBeatEnvelope(
+        const std::vector<const WaveFunction*>& waves,
+        double duration = 10.0,
+        double sampleRate = 100.0
+    );
     
-    // Standing waves
+    // Standing waves (nodes and antinodes in order of position)
     std::vector<InterferenceNode> findInterferenceNodes(
         const std::vector<const WaveFunction*>& waves,
         double time = 0.0,
@@ -71,6 +84,17 @@ public:
         double threshold = 0.1
     );
     
+    // Coarse scan followed by bracketed Brent refinement of zero crossings
+    // (nodes) and slope sign changes (antinodes); positions are sub-sample accurate
+    std::vector<InterferenceNode> findInterferenceNodesAdaptive(
+        const std::vector<const WaveFunction*>& waves,
+        double time = 0.0,
+        double length = 10.0,
+        int numCoarsePoints = 128,
+        double threshold = 0.1,
+        double tolerance = 1e-9
+    );
+    
     std::vector<double> calculateStandingWave(
         double amplitude1, double amplitude2,
         double frequency,
@@ -91,6 +115,12 @@ public:
         double frequencyTolerance = 0.01
     );
     
+    // Resonant clusters, beat pairs and harmonic relations in O(n log n)
+    FrequencyAnalysis analyzeFrequencies(
+        const std::vector<const WaveFunction*>& waves,
+        double frequencyTolerance = 0.01
+    );
+    
     double calculateResonanceAmplification(
         const std::vector<const WaveFunction*>& waves
     );
@@ -112,6 +142,41 @@ public:
         int numPoints = 1000
     );
     
+    // Broadband patterns: the spectrum-weighted sum of the monochromatic patterns,
+    // normalized so the zero-order maximum is 1. Parallel across screen tiles.
+    std::vector<double> calculatePolychromaticDoubleSlitPattern(
+        const std::vector<SpectralSample>& spectrum,
+        double slitSeparation,
+        double screenDistance,
+        double screenWidth = 10.0,
+        int numPoints = 1000,
+        double slitWidth = 0.0,     // 0 for ideal slits (no diffraction envelope)
+        unsigned int numThreads = 0
+    );
+    
+    std::vector<double> calculatePolychromaticSingleSlitDiffraction(
+        const std::vector<SpectralSample>& spectrum,
+        double slitWidth,
+        double screenDistance,
+        double screenWidth = 10.0,
+        int numPoints = 1000,
+        unsigned int numThreads = 0
+    );
+    
+    // Spectrum builders
+    std::vector<SpectralSample> createBlackbodySpectrum(
+        double temperature,
+        double minWavelength = 380e-9,
+        double maxWavelength = 750e-9,
+        int numSamples = 256
+    );
+    
+    std::vector<SpectralSample> createGaussianSpectrum(
+        double centerWavelength,
+        double bandwidth,   // FWHM
+        int numSamples = 64
+    );
+    
     // Utility functions
     double calculateTotalAmplitude(
         const std::vector<const WaveFunction*>& waves,
@@ -127,10 +192,39 @@ public:
     );
 
 private:
-    // Helper functions
-    std::vector<double> findLocalExtrema(const std::vector<double>& data, bool findMaxima = true);
+    // Helper functions. Sample buffers come from scratchBuffer(), a per-thread
+    // vector, so the calculator stays stateless and safe to share between threads
+    static std::vector<double>& scratchBuffer();
+    
+    static double sampleSuperposition(
+        const std::vector<const WaveFunction*>& waves,
+        double time,
+        double length,
+        int numPoints,
+        std::vector<double>& amplitudes
+    );  // Fills amplitudes with |y(x)|, returns dx
+    
+    static double analyzeSamples(
+        const std::vector<double>& amplitudes,
+        double dx,
+        double threshold,
+        std::vector<double>* nodePositions,
+        std::vector<double>* antinodePositions,
+        std::vector<InterferenceNode>* nodes
+    );  // Single pass over amplitudes, returns peak amplitude
+    
     double calculateRMSAmplitude(const std::vector<double>& data);
     std::string generateDescription(const InterferenceResult& result);
+    
+    std::vector<double> integrateSpectrum(
+        const std::vector<SpectralSample>& spectrum,
+        double slitSeparation,
+        double slitWidth,
+        double screenDistance,
+        double screenWidth,
+        int numPoints,
+        unsigned int numThreads
+    );
 };
 
 #endif // INTERFERENCE_CALCULATOR_H
\ No newline at end of file
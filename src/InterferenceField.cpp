@@ -0,0 +1,83 @@
+#include "InterferenceField.h"
+#include "PhysicsConstants.h"
+#include <cmath>
+#include <algorithm>
+
+InterferenceField::InterferenceField(double velocity) : velocity_(1.0) {
+    setVelocity(velocity);
+}
+
+void InterferenceField::setVelocity(double velocity) {
+    velocity_ = velocity > 0.0 ? velocity : 1.0;
+    for (auto& group : groups_) {
+        group.waveNumber = Physics::TWO_PI * group.frequency / velocity_;
+    }
+}
+
+void InterferenceField::addSource(double x, double y, const WaveFunction& wave, int maxHarmonics) {
+    PhasorEngine phasors;
+    phasors.addWave(wave, maxHarmonics);
+    for (const auto& component : phasors.getComponents()) {
+        addSource(x, y, component);
+    }
+}
+
+void InterferenceField::addSource(double x, double y, const PhasorComponent& component) {
+    double tolerance = FREQUENCY_TOLERANCE * std::max(1.0, std::abs(component.frequency));
+    auto group = std::find_if(groups_.begin(), groups_.end(), [&](const FrequencyGroup& g) {
+        return std::abs(g.frequency - component.frequency) <= tolerance;
+    });
+
+    if (group == groups_.end()) {
+        groups_.push_back({component.frequency, Physics::TWO_PI * component.frequency / velocity_,
+                           0.0, emitters_.size(), 0});
+        group = groups_.end() - 1;
+    }
+
+    // Insert at the end of the group and shift the groups stored after it
+    size_t position = group->first + group->count;
+    emitters_.insert(emitters_.begin() + position, {x, y, component.amplitude, component.phase});
+    group->amplitudeSum += std::abs(component.amplitude);
+    ++group->count;
+
+    for (auto& other : groups_) {
+        if (other.first > group->first) ++other.first;
+    }
+}
+
+void InterferenceField::clear() {
+    emitters_.clear();
+    groups_.clear();
+}
+
+double InterferenceField::evaluateIntensity(double x, double y) const {
+    double intensity = 0.0;
+
+    for (const auto& group : groups_) {
+        double re = 0.0;
+        double im = 0.0;
+        const Emitter* emitter = emitters_.data() + group.first;
+
+        for (size_t i = 0; i < group.count; ++i) {
+            double dx = x - emitter[i].x;
+            double dy = y - emitter[i].y;
+            double r = std::sqrt(dx * dx + dy * dy);
+            double angle = emitter[i].phase - group.waveNumber * r;
+            re += emitter[i].amplitude * std::cos(angle);
+            im += emitter[i].amplitude * std::sin(angle);
+        }
+
+        // Mean square of a sinusoid of amplitude |phasor|
+        intensity += 0.5 * (re * re + im * im);
+    }
+
+    return intensity;
+}
+
+double InterferenceField::getPeakIntensity() const {
+    double peak = 0.0;
+    for (const auto& group : groups_) {
+        peak += 0.5 * group.amplitudeSum * group.amplitudeSum;
+    }
+    return peak;
+}
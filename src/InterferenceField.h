@@ -0,0 +1,54 @@
+#ifndef INTERFERENCE_FIELD_H
+#define INTERFERENCE_FIELD_H
+
+#include "PhasorEngine.h"
+#include <vector>
+#include <cstddef>
+
+// Point sources in a plane, each radiating circular waves of constant
+// amplitude. Non-sinusoidal waves radiate their Fourier components.
+class InterferenceField {
+public:
+    InterferenceField(double velocity = 1.0);
+    ~InterferenceField() = default;
+
+    void addSource(double x, double y, const WaveFunction& wave, int maxHarmonics = PhasorEngine::DEFAULT_HARMONICS);
+    void addSource(double x, double y, const PhasorComponent& component);
+    void clear();
+
+    void setVelocity(double velocity);
+    double getVelocity() const { return velocity_; }
+    size_t getEmitterCount() const { return emitters_.size(); }
+
+    // Time-averaged intensity <y²>: components of equal frequency add as
+    // amplitudes, components of different frequencies add as intensities
+    double evaluateIntensity(double x, double y) const;
+
+    // Upper bound of the intensity, reached where every group is in phase
+    double getPeakIntensity() const;
+
+private:
+    struct Emitter {
+        double x;
+        double y;
+        double amplitude;
+        double phase;
+    };
+
+    // Emitters sharing a frequency are stored contiguously
+    struct FrequencyGroup {
+        double frequency;
+        double waveNumber;
+        double amplitudeSum;
+        size_t first;
+        size_t count;
+    };
+
+    std::vector<Emitter> emitters_;
+    std::vector<FrequencyGroup> groups_;
+    double velocity_;
+
+    static constexpr double FREQUENCY_TOLERANCE = 1e-9;
+};
+
+#endif // INTERFERENCE_FIELD_H
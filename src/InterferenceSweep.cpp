@@ -0,0 +1,144 @@
+#include "InterferenceSweep.h"
+#include "PhysicsConstants.h"
+#include "ParallelFor.h"
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+InterferenceSweep::InterferenceSweep(unsigned int numThreads) : numThreads_(1) {
+    setThreadCount(numThreads);
+}
+
+void InterferenceSweep::setThreadCount(unsigned int numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    numThreads_ = std::max(1u, numThreads);
+}
+
+SweepResult InterferenceSweep::run(const SweepGrid& grid) {
+    SweepResult result = {0, 0, 0, 0, {}};
+    if (!hasValidWavelengths(grid)) return result;
+
+    result.numWavelengths = grid.wavelengths.size();
+    result.numSeparations = grid.slitSeparations.size();
+    result.numDistances = grid.screenDistances.size();
+    result.numPoints = grid.numPoints >= 2 ? static_cast<size_t>(grid.numPoints) : 0;
+
+    size_t numCombinations = result.numWavelengths * result.numSeparations * result.numDistances;
+    if (numCombinations == 0 || result.numPoints == 0) return result;
+
+    result.intensity.resize(numCombinations * result.numPoints);
+
+    auto sinTable = buildSinTable(grid);
+    evaluateParallel(grid, sinTable, 0, numCombinations, result.intensity.data());
+
+    return result;
+}
+
+bool InterferenceSweep::runToFile(const SweepGrid& grid, const std::string& fileName, size_t combinationsPerBlock) {
+    if (!hasValidWavelengths(grid)) return false;
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    size_t numPoints = grid.numPoints >= 2 ? static_cast<size_t>(grid.numPoints) : 0;
+    size_t numCombinations = grid.wavelengths.size() * grid.slitSeparations.size() * grid.screenDistances.size();
+    if (numCombinations == 0 || numPoints == 0) return true;
+
+    auto sinTable = buildSinTable(grid);
+
+    size_t blockSize = std::max<size_t>(combinationsPerBlock, 1);
+    std::vector<double> block(blockSize * numPoints);
+
+    for (size_t first = 0; first < numCombinations; first += blockSize) {
+        size_t last = std::min(first + blockSize, numCombinations);
+        evaluateParallel(grid, sinTable, first, last, block.data());
+
+        file.write(reinterpret_cast<const char*>(block.data()),
+                   static_cast<std::streamsize>((last - first) * numPoints * sizeof(double)));
+        if (!file) return false;
+    }
+
+    return true;
+}
+
+bool InterferenceSweep::hasValidWavelengths(const SweepGrid& grid) const {
+    return std::all_of(grid.wavelengths.begin(), grid.wavelengths.end(),
+                       [](double wavelength) { return wavelength > 0.0; });
+}
+
+std::vector<double> InterferenceSweep::buildSinTable(const SweepGrid& grid) const {
+    size_t numPoints = static_cast<size_t>(grid.numPoints);
+    std::vector<double> sinTable(grid.screenDistances.size() * numPoints);
+
+    double dy = grid.screenWidth / (grid.numPoints - 1);
+
+    for (size_t d = 0; d < grid.screenDistances.size(); ++d) {
+        double distance = grid.screenDistances[d];
+        double* row = sinTable.data() + d * numPoints;
+
+        for (size_t p = 0; p < numPoints; ++p) {
+            double y = -grid.screenWidth / 2.0 + p * dy;
+            row[p] = y / std::sqrt(y * y + distance * distance);
+        }
+    }
+
+    return sinTable;
+}
+
+void InterferenceSweep::evaluateRange(
+    const SweepGrid& grid,
+    const std::vector<double>& sinTable,
+    size_t firstCombination,
+    size_t lastCombination,
+    double* output) const {
+
+    size_t numPoints = static_cast<size_t>(grid.numPoints);
+    size_t numSeparations = grid.slitSeparations.size();
+    size_t numDistances = grid.screenDistances.size();
+
+    for (size_t combination = firstCombination; combination < lastCombination; ++combination) {
+        size_t d = combination % numDistances;
+        size_t s = (combination / numDistances) % numSeparations;
+        size_t w = combination / (numDistances * numSeparations);
+
+        double wavelength = grid.wavelengths[w];
+        const double* sinTheta = sinTable.data() + d * numPoints;
+        double* pattern = output + (combination - firstCombination) * numPoints;
+
+        // Only the phase scales change per combination
+        double fringeScale = Physics::PI * grid.slitSeparations[s] / wavelength;
+        double envelopeScale = Physics::PI * grid.slitWidth / wavelength;
+
+        for (size_t p = 0; p < numPoints; ++p) {
+            double c = std::cos(fringeScale * sinTheta[p]);
+            pattern[p] = c * c;
+        }
+
+        if (grid.slitWidth > 0.0) {
+            for (size_t p = 0; p < numPoints; ++p) {
+                double beta = envelopeScale * sinTheta[p];
+                double sinc = std::abs(beta) < 1e-12 ? 1.0 : std::sin(beta) / beta;
+                pattern[p] *= sinc * sinc;
+            }
+        }
+    }
+}
+
+void InterferenceSweep::evaluateParallel(
+    const SweepGrid& grid,
+    const std::vector<double>& sinTable,
+    size_t firstCombination,
+    size_t lastCombination,
+    double* output) const {
+
+    // One combination per task; each writes its own pattern of the output
+    size_t numPoints = static_cast<size_t>(grid.numPoints);
+
+    parallelFor(lastCombination - firstCombination, numThreads_, [&](size_t task) {
+        size_t combination = firstCombination + task;
+        evaluateRange(grid, sinTable, combination, combination + 1, output + task * numPoints);
+    });
+}
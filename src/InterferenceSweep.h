@@ -0,0 +1,76 @@
+#ifndef INTERFERENCE_SWEEP_H
+#define INTERFERENCE_SWEEP_H
+
+#include <vector>
+#include <string>
+
+// Parameter grid for a double-slit sweep. Every combination of wavelength,
+// slit separation and screen distance is evaluated over the same screen.
+struct SweepGrid {
+    std::vector<double> wavelengths;
+    std::vector<double> slitSeparations;
+    std::vector<double> screenDistances;
+    double slitWidth = 0.0;       // 0 for ideal slits (no single-slit envelope)
+    double screenWidth = 10.0;
+    int numPoints = 1000;
+};
+
+// Intensities stored contiguously as [wavelength][separation][distance][point]
+struct SweepResult {
+    size_t numWavelengths;
+    size_t numSeparations;
+    size_t numDistances;
+    size_t numPoints;
+    std::vector<double> intensity;
+
+    size_t index(size_t w, size_t s, size_t d, size_t p = 0) const {
+        return ((w * numSeparations + s) * numDistances + d) * numPoints + p;
+    }
+
+    const double* pattern(size_t w, size_t s, size_t d) const {
+        return intensity.data() + index(w, s, d);
+    }
+};
+
+class InterferenceSweep {
+public:
+    InterferenceSweep(unsigned int numThreads = 0);  // 0 = hardware concurrency
+    ~InterferenceSweep() = default;
+
+    // Evaluate the whole grid into one tensor; empty if any wavelength is <= 0
+    SweepResult run(const SweepGrid& grid);
+
+    // Evaluate the grid in blocks and append raw float64 patterns to a file in
+    // tensor order, so the full result never has to fit in memory. Fails if any
+    // wavelength is <= 0
+    bool runToFile(const SweepGrid& grid, const std::string& fileName, size_t combinationsPerBlock = 256);
+
+    void setThreadCount(unsigned int numThreads);
+    unsigned int getThreadCount() const { return numThreads_; }
+
+private:
+    bool hasValidWavelengths(const SweepGrid& grid) const;
+
+    // sin(theta) per screen point for each distance (hoisted out of the sweep)
+    std::vector<double> buildSinTable(const SweepGrid& grid) const;
+
+    void evaluateRange(
+        const SweepGrid& grid,
+        const std::vector<double>& sinTable,
+        size_t firstCombination,
+        size_t lastCombination,
+        double* output
+    ) const;
+
+    void evaluateParallel(
+        const SweepGrid& grid,
+        const std::vector<double>& sinTable,
+        size_t firstCombination,
+        size_t lastCombination,
+        double* output
+    ) const;
+
+    unsigned int numThreads_;
+};
+
+#endif // INTERFERENCE_SWEEP_H
@@ -5,6 +5,10 @@
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QFileDialog>
 #include <QtCore/QStandardPaths>
+#include <QtGui/QGuiApplication>
+#include <QtGui/QScreen>
+#include <QtGui/QWindow>
+#include <algorithm>
 #include "WaveFunction.h"
 
 MainWindow::MainWindow(QWidget *parent)
@@ -12,6 +16,8 @@ MainWindow::MainWindow(QWidget *parent)
     , m_centralWidget(nullptr)
     , m_waveEngine(std::make_unique<WaveEngine>())
     , m_animationTimer(new QTimer(this))
+    , m_lastTickNs(0)
+    , m_exportTimer(new QTimer(this))
     , m_isPlaying(false)
     , m_currentTime(0.0)
     , m_animationSpeed(1.0)
@@ -23,9 +29,13 @@ MainWindow::MainWindow(QWidget *parent)
     m_waveEngine->addWave(std::make_unique<SinusoidalWave>(2.0, 1.0, 0.0));
     
     // Setup animation timer
+    m_animationTimer->setTimerType(Qt::PreciseTimer);
     m_animationTimer->setInterval(TIMER_INTERVAL);
     connect(m_animationTimer, &QTimer::timeout, [this]() { onAnimationTimer(); });
     
+    m_exportTimer->setInterval(EXPORT_POLL_INTERVAL);
+    connect(m_exportTimer, &QTimer::timeout, [this]() { onExportTimer(); });
+    
     // Initial update
     updateWaveDisplay();
     updateInfoPanel();
@@ -155,16 +165,57 @@ void MainWindow::setupControlPanel() {
     m_addWaveButton = new QPushButton("+ Add Wave");
     m_removeWaveButton = new QPushButton("- Remove");
     m_clearWavesButton = new QPushButton("Clear All");
+    m_loadScenarioButton = new QPushButton("📂 Load Scenario");
     
     waveLayout->addWidget(m_addWaveButton);
     waveLayout->addWidget(m_removeWaveButton);
     waveLayout->addWidget(m_clearWavesButton);
+    waveLayout->addWidget(m_loadScenarioButton);
     
     connect(m_addWaveButton, &QPushButton::clicked, [this]() { onAddWaveClicked(); });
     connect(m_removeWaveButton, &QPushButton::clicked, [this]() { onRemoveWaveClicked(); });
     connect(m_clearWavesButton, &QPushButton::clicked, [this]() { onClearWavesClicked(); });
+    connect(m_loadScenarioButton, &QPushButton::clicked, [this]() { onLoadScenarioClicked(); });
     
     m_controlLayout->addWidget(waveFrame, 5, 0, 1, 3);
+    
+    // Timing overlay
+    m_frameStatsCheck = new QCheckBox("Show frame timing");
+    m_controlLayout->addWidget(m_frameStatsCheck, 6, 0, 1, 3);
+    connect(m_frameStatsCheck, &QCheckBox::toggled, [this](bool checked) {
+        for (WaveVisualizer* tab : {m_simpleWaveTab, m_superpositionTab, m_spectrumTab, m_spectrogramTab,
+                                    m_interferenceTab}) {
+            tab->setShowFrameStats(checked);
+        }
+    });
+    
+    // Time view follows the animation, sampling only what scrolls in
+    m_scrollingCheck = new QCheckBox("Scrolling time window");
+    m_controlLayout->addWidget(m_scrollingCheck, 7, 0, 1, 3);
+    connect(m_scrollingCheck, &QCheckBox::toggled, [this](bool checked) {
+        m_simpleWaveTab->setScrolling(checked);
+    });
+    
+    // Export length, used by the Save button
+    QFrame *exportFrame = new QFrame();
+    QHBoxLayout *exportLayout = new QHBoxLayout(exportFrame);
+    exportLayout->setContentsMargins(0, 0, 0, 0);
+    
+    m_exportDurationSpin = new QDoubleSpinBox();
+    m_exportDurationSpin->setRange(0.1, 1e6);
+    m_exportDurationSpin->setValue(10.0);
+    m_exportDurationSpin->setSuffix(" s");
+    
+    m_exportRateSpin = new QDoubleSpinBox();
+    m_exportRateSpin->setRange(1.0, 1e7);
+    m_exportRateSpin->setValue(1000.0);
+    m_exportRateSpin->setSuffix(" Hz");
+    
+    exportLayout->addWidget(m_exportDurationSpin);
+    exportLayout->addWidget(m_exportRateSpin);
+    
+    m_controlLayout->addWidget(new QLabel("Export:"), 8, 0);
+    m_controlLayout->addWidget(exportFrame, 8, 1, 1, 2);
 }
 
 void MainWindow::setupVisualizationPanel() {
@@ -188,6 +239,18 @@ void MainWindow::setupVisualizationPanel() {
     m_spectrumTab->setVisualizationMode(VisualizationMode::FREQUENCY_DOMAIN);
     m_tabWidget->addTab(m_spectrumTab, "📊 Spectrum");
     
+    // Spectrogram tab
+    m_spectrogramTab = new WaveVisualizer();
+    m_spectrogramTab->setWaveEngine(m_waveEngine.get());
+    m_spectrogramTab->setVisualizationMode(VisualizationMode::SPECTROGRAM);
+    m_tabWidget->addTab(m_spectrogramTab, "🌈 Spectrogram");
+    
+    // Interference field tab
+    m_interferenceTab = new WaveVisualizer();
+    m_interferenceTab->setWaveEngine(m_waveEngine.get());
+    m_interferenceTab->setVisualizationMode(VisualizationMode::INTERFERENCE_PATTERN);
+    m_tabWidget->addTab(m_interferenceTab, "💡 Interference");
+    
     // Theory tab
     m_theoryTab = new QTextEdit();
     m_theoryTab->setReadOnly(true);
@@ -286,6 +349,9 @@ void MainWindow::onPlayPauseClicked() {
         m_isPlaying = false;
         m_statusLabel->setText("Paused");
     } else {
+        configureAnimationTimer();
+        m_animationClock.start();
+        m_lastTickNs = 0;
         m_animationTimer->start();
         m_playPauseButton->setText("⏸ Pause");
         m_isPlaying = true;
@@ -317,13 +383,53 @@ void MainWindow::onResetClicked() {
 }
 
 void MainWindow::onSaveClicked() {
+    // While an export runs the button cancels it; onExportTimer reports the outcome
+    if (m_exporter.isRunning()) {
+        m_exporter.cancel();
+        return;
+    }
+    
     QString fileName = QFileDialog::getSaveFileName(this, "Save Wave Data", 
         QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/wave_data.csv",
-        "CSV Files (*.csv);;All Files (*)");
+        "CSV Files (*.csv);;Binary Files (*.bin);;All Files (*)");
     
-    if (!fileName.isEmpty()) {
-        // TODO: Implement save functionality
-        m_statusLabel->setText("Saved to: " + fileName);
+    if (fileName.isEmpty()) return;
+    
+    ExportSettings settings;
+    settings.format = fileName.endsWith(".bin", Qt::CaseInsensitive) ? ExportFormat::BINARY : ExportFormat::CSV;
+    settings.duration = m_exportDurationSpin->value();
+    settings.sampleRate = m_exportRateSpin->value();
+    
+    if (!m_exporter.start(*m_waveEngine, fileName.toStdString(), settings)) {
+        m_statusLabel->setText("Export failed: " + QString::fromStdString(m_exporter.getError()));
+        return;
+    }
+    
+    m_exportFileName = fileName;
+    m_progressBar->setRange(0, 1000);
+    m_progressBar->setValue(0);
+    m_progressBar->setVisible(true);
+    m_saveButton->setText("✖ Cancel");
+    m_statusLabel->setText("Exporting to: " + fileName);
+    m_exportTimer->start();
+}
+
+void MainWindow::onExportTimer() {
+    if (m_exporter.isRunning()) {
+        m_progressBar->setValue(static_cast<int>(m_exporter.getProgress() * 1000));
+        return;
+    }
+    
+    m_exportTimer->stop();
+    m_progressBar->setVisible(false);
+    m_saveButton->setText("💾 Save");
+    
+    if (m_exporter.succeeded()) {
+        m_statusLabel->setText(QString("Saved %1 samples to: %2")
+                               .arg(m_exporter.getSamplesWritten())
+                               .arg(m_exportFileName));
+    } else {
+        m_statusLabel->setText("Export failed: " + QString::fromStdString(m_exporter.getError()));
     }
 }
 
@@ -333,28 +439,7 @@ void MainWindow::onAddWaveClicked() {
     double frequency = m_frequencySpin->value();
     double phase = m_phaseSpin->value();
     
-    std::unique_ptr<WaveFunction> wave;
-    switch (type) {
-        case WaveType::SINUSOIDAL:
-            wave = std::make_unique<SinusoidalWave>(amplitude, frequency, phase);
-            break;
-        case WaveType::COSINE:
-            wave = std::make_unique<CosineWave>(amplitude, frequency, phase);
-            break;
-        case WaveType::SQUARE:
-            wave = std::make_unique<SquareWave>(amplitude, frequency, phase);
-            break;
-        case WaveType::TRIANGULAR:
-            wave = std::make_unique<TriangularWave>(amplitude, frequency, phase);
-            break;
-        case WaveType::SAWTOOTH:
-            wave = std::make_unique<SawtoothWave>(amplitude, frequency, phase);
-            break;
-        default:
-            wave = std::make_unique<SinusoidalWave>(amplitude, frequency, phase);
-    }
-    
-    m_waveEngine->addWave(std::move(wave));
+    m_waveEngine->addWave(WaveFunction::create(type, amplitude, frequency, phase));
     updateWaveDisplay();
     updateInfoPanel();
     m_statusLabel->setText(QString("Added wave. Total: %1").arg(m_waveEngine->getWaveCount()));
@@ -377,17 +462,77 @@ void MainWindow::onClearWavesClicked() {
     m_statusLabel->setText("Cleared all waves, added default sine wave");
 }
 
+void MainWindow::onLoadScenarioClicked() {
+    QString fileName = QFileDialog::getOpenFileName(this, "Load Scenario",
+        QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation),
+        "Scenario Files (*.scn);;All Files (*)");
+    
+    if (fileName.isEmpty()) return;
+    
+    ScenarioFile file;
+    Scenario scenario;
+    if (!file.load(fileName.toStdString(), scenario)) {
+        m_statusLabel->setText("Load failed: " + QString::fromStdString(file.getError()));
+        return;
+    }
+    
+    onStopClicked();
+    ScenarioFile::apply(scenario, *m_waveEngine);
+    
+    // A scenario without waves keeps the default one, as Clear All does
+    if (m_waveEngine->getWaveCount() == 0) {
+        m_waveEngine->addWave(std::make_unique<SinusoidalWave>(2.0, 1.0, 0.0));
+    }
+    
+    // Exports follow the scenario's sampling
+    m_exportDurationSpin->setValue(scenario.duration);
+    m_exportRateSpin->setValue(scenario.sampleRate);
+    
+    updateWaveDisplay();
+    updateInfoPanel();
+    m_statusLabel->setText(QString("Loaded %1: %2 waves")
+                           .arg(scenario.name.empty() ? fileName : QString::fromStdString(scenario.name))
+                           .arg(m_waveEngine->getWaveCount()));
+}
+
 void MainWindow::onTabChanged(int index) {
     Q_UNUSED(index)
     updateWaveDisplay();
 }
 
 void MainWindow::onAnimationTimer() {
-    m_currentTime += TIMER_INTERVAL / 1000.0 * m_animationSpeed;
+    // Advance by real elapsed time so slow frames do not make the simulation
+    // drift; after a long stall jump by at most MAX_FRAME_STEP
+    qint64 now = m_animationClock.nsecsElapsed();
+    double elapsed = (now - m_lastTickNs) * 1e-9;
+    m_lastTickNs = now;
+    m_currentTime += std::min(elapsed, MAX_FRAME_STEP) * m_animationSpeed;
+    
+    // The previous frame is still being produced: drop this one instead of
+    // queueing more work; the next tick catches up on time
+    WaveVisualizer* visible = currentVisualizer();
+    if (visible && visible->isBusy()) {
+        visible->recordDroppedFrame();
+        return;
+    }
+    
     updateWaveDisplay();
     updateInfoPanel();
 }
 
+void MainWindow::configureAnimationTimer() {
+    // Tick once per display refresh; Qt widgets cannot wait on vsync directly
+    QScreen *screen = windowHandle() ? windowHandle()->screen() : QGuiApplication::primaryScreen();
+    double refreshRate = screen ? screen->refreshRate() : 0.0;
+    
+    int interval = refreshRate > 0.0 ? std::max(1, static_cast<int>(1000.0 / refreshRate)) : TIMER_INTERVAL;
+    m_animationTimer->setInterval(interval);
+}
+
+WaveVisualizer* MainWindow::currentVisualizer() const {
+    return dynamic_cast<WaveVisualizer*>(m_tabWidget->currentWidget());
+}
+
 void MainWindow::updateWaveParameters() {
     if (m_waveEngine->getWaveCount() > 0) {
         WaveFunction* wave = const_cast<WaveFunction*>(m_waveEngine->getWave(0));
@@ -402,13 +547,13 @@ void MainWindow::updateWaveParameters() {
 }
 
 void MainWindow::updateWaveDisplay() {
+    // Each tab only marks itself stale here; the visible one regenerates once
+    // on the next event-loop pass and hidden ones catch up when shown
     m_simpleWaveTab->setCurrentTime(m_currentTime);
     m_superpositionTab->setCurrentTime(m_currentTime);
     m_spectrumTab->setCurrentTime(m_currentTime);
-    
-    m_simpleWaveTab->updateVisualization();
-    m_superpositionTab->updateVisualization();
-    m_spectrumTab->updateVisualization();
+    m_spectrogramTab->setCurrentTime(m_currentTime);
+    m_interferenceTab->setCurrentTime(m_currentTime);
 }
 
 void MainWindow::updateInfoPanel() {
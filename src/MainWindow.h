@@ -18,9 +18,13 @@
 #include <QtWidgets/QTextEdit>
 #include <QtWidgets/QFrame>
 #include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtWidgets/QCheckBox>
 #include <memory>
 #include "WaveEngine.h"
 #include "WaveVisualizer.h"
+#include "SeriesExporter.h"
+#include "ScenarioFile.h"
 
 class MainWindow : public QMainWindow {
 
@@ -40,8 +44,10 @@ public slots:
     void onAddWaveClicked();
     void onRemoveWaveClicked();
     void onClearWavesClicked();
+    void onLoadScenarioClicked();
     void onTabChanged(int index);
     void onAnimationTimer();
+    void onExportTimer();
 
 private:
     void setupUI();
@@ -52,6 +58,8 @@ private:
     void updateWaveDisplay();
     void updateInfoPanel();
     void updateStatus();
+    void configureAnimationTimer();
+    WaveVisualizer* currentVisualizer() const;
     
     // Central widget and layouts
     QWidget *m_centralWidget;
@@ -75,12 +83,19 @@ private:
     QPushButton *m_addWaveButton;
     QPushButton *m_removeWaveButton;
     QPushButton *m_clearWavesButton;
+    QPushButton *m_loadScenarioButton;
+    QCheckBox *m_frameStatsCheck;
+    QCheckBox *m_scrollingCheck;
+    QDoubleSpinBox *m_exportDurationSpin;
+    QDoubleSpinBox *m_exportRateSpin;
     
     // Visualization Panel
     QTabWidget *m_tabWidget;
     WaveVisualizer *m_simpleWaveTab;
     WaveVisualizer *m_superpositionTab;
     WaveVisualizer *m_spectrumTab;
+    WaveVisualizer *m_spectrogramTab;
+    WaveVisualizer *m_interferenceTab;
     QTextEdit *m_theoryTab;
     
     // Information Panel
@@ -103,6 +118,11 @@ private:
     // Core components
     std::unique_ptr<WaveEngine> m_waveEngine;
     QTimer *m_animationTimer;
+    QElapsedTimer m_animationClock;    // Monotonic; simulation time follows it
+    qint64 m_lastTickNs;
+    SeriesExporter m_exporter;
+    QTimer *m_exportTimer;             // Polls the exporter while it runs
+    QString m_exportFileName;
     
     // State variables
     bool m_isPlaying;
@@ -117,7 +137,9 @@ private:
     static constexpr double MAX_FREQUENCY = 10.0;
     static constexpr double MIN_PHASE = 0.0;
     static constexpr double MAX_PHASE = 360.0;
-    static constexpr int TIMER_INTERVAL = 50; // ms (20 FPS)
+    static constexpr int TIMER_INTERVAL = 16; // ms, when the refresh rate is unknown
+    static constexpr double MAX_FRAME_STEP = 0.25; // s of simulation time per tick
+    static constexpr int EXPORT_POLL_INTERVAL = 100; // ms
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
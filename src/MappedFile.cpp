@@ -0,0 +1,38 @@
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path, size_t minimumSize) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0 || static_cast<size_t>(info.st_size) < minimumSize) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);    // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) return false;
+
+    mapping_ = mapping;
+    size_ = size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapping_) munmap(mapping_, size_);
+
+    mapping_ = nullptr;
+    size_ = 0;
+}
@@ -0,0 +1,29 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file, unmapped on close or destruction
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Fails if the file cannot be mapped or is shorter than minimumSize bytes
+    bool open(const std::string& path, size_t minimumSize = 0);
+    void close();
+    bool isOpen() const { return mapping_ != nullptr; }
+
+    const unsigned char* data() const { return static_cast<const unsigned char*>(mapping_); }
+    size_t size() const { return size_; }
+
+private:
+    void* mapping_ = nullptr;
+    size_t size_ = 0;
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,132 @@
+#include "MinMaxPyramid.h"
+#include <cmath>
+#include <algorithm>
+
+void MinMaxPyramid::build(const std::vector<double>& samples, double startX, double dx) {
+    if (samples.empty() || dx <= 0.0) {
+        clear();
+        return;
+    }
+
+    startX_ = startX;
+    dx_ = dx;
+
+    // Count the levels first so rebuilding at the same size reuses every buffer
+    size_t numLevels = 1;
+    for (size_t size = samples.size(); size > 1; size = (size + 1) / 2) {
+        ++numLevels;
+    }
+    levelMin_.resize(numLevels);
+    levelMax_.resize(numLevels);
+
+    // Level 0 holds the raw samples in both arrays
+    levelMin_[0].assign(samples.begin(), samples.end());
+    levelMax_[0].assign(samples.begin(), samples.end());
+
+    for (size_t level = 1; level < numLevels; ++level) {
+        const auto& prevMin = levelMin_[level - 1];
+        const auto& prevMax = levelMax_[level - 1];
+        size_t size = (prevMin.size() + 1) / 2;
+
+        auto& mins = levelMin_[level];
+        auto& maxs = levelMax_[level];
+        mins.resize(size);
+        maxs.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            size_t a = 2 * i;
+            size_t b = std::min(a + 1, prevMin.size() - 1);
+            mins[i] = std::min(prevMin[a], prevMin[b]);
+            maxs[i] = std::max(prevMax[a], prevMax[b]);
+        }
+    }
+}
+
+void MinMaxPyramid::clear() {
+    levelMin_.clear();
+    levelMax_.clear();
+}
+
+bool MinMaxPyramid::findRange(double x0, double x1, double& minY, double& maxY) const {
+    size_t first, last;
+    if (!toIndexRange(x0, x1, first, last)) return false;
+
+    findIndexRange(first, last, minY, maxY);
+    return true;
+}
+
+void MinMaxPyramid::decimate(double x0, double x1, size_t columns, std::vector<double>& xOut, std::vector<double>& yOut) const {
+    xOut.clear();
+    yOut.clear();
+
+    size_t first, last;
+    if (columns == 0 || !toIndexRange(x0, x1, first, last)) return;
+
+    const auto& raw = levelMin_[0];
+    size_t count = last - first;
+
+    if (count <= 2 * columns) {
+        xOut.reserve(count);
+        yOut.reserve(count);
+        for (size_t i = first; i < last; ++i) {
+            xOut.push_back(startX_ + i * dx_);
+            yOut.push_back(raw[i]);
+        }
+        return;
+    }
+
+    xOut.reserve(2 * columns);
+    yOut.reserve(2 * columns);
+
+    double previous = raw[first];
+    for (size_t c = 0; c < columns; ++c) {
+        size_t a = first + c * count / columns;
+        size_t b = first + (c + 1) * count / columns;
+        if (a >= b) continue;
+
+        double minY, maxY;
+        findIndexRange(a, b, minY, maxY);
+
+        // Order the pair so the polyline does not cross itself between columns
+        double x = startX_ + (a + b - 1) * 0.5 * dx_;
+        bool minFirst = std::abs(previous - minY) <= std::abs(previous - maxY);
+        xOut.push_back(x);
+        yOut.push_back(minFirst ? minY : maxY);
+        xOut.push_back(x);
+        yOut.push_back(minFirst ? maxY : minY);
+        previous = minFirst ? maxY : minY;
+    }
+}
+
+void MinMaxPyramid::findIndexRange(size_t first, size_t last, double& minY, double& maxY) const {
+    minY = levelMin_[0][first];
+    maxY = levelMax_[0][first];
+
+    // Greedily take the largest aligned block that fits, as in a segment tree
+    size_t i = first;
+    while (i < last) {
+        size_t level = 0;
+        while (level + 1 < levelMin_.size() &&
+               (i & ((size_t(1) << (level + 1)) - 1)) == 0 &&
+               i + (size_t(1) << (level + 1)) <= last) {
+            ++level;
+        }
+
+        size_t block = i >> level;
+        minY = std::min(minY, levelMin_[level][block]);
+        maxY = std::max(maxY, levelMax_[level][block]);
+        i += size_t(1) << level;
+    }
+}
+
+bool MinMaxPyramid::toIndexRange(double x0, double x1, size_t& first, size_t& last) const {
+    size_t n = getSampleCount();
+    if (n == 0 || x1 < x0) return false;
+
+    double lo = std::ceil((x0 - startX_) / dx_);
+    double hi = std::floor((x1 - startX_) / dx_);
+    if (hi < 0.0 || lo > static_cast<double>(n - 1)) return false;
+
+    first = static_cast<size_t>(std::max(lo, 0.0));
+    last = static_cast<size_t>(std::min(hi, static_cast<double>(n - 1))) + 1;
+    return first < last;
+}
@@ -0,0 +1,43 @@
+#ifndef MIN_MAX_PYRAMID_H
+#define MIN_MAX_PYRAMID_H
+
+#include <vector>
+#include <cstddef>
+
+// Multi-resolution min/max summary of a uniformly sampled signal. Level k
+// holds the min and max of each aligned block of 2^k samples, so the extrema
+// of any sample range are found in O(log n) and a plot of any zoom level can
+// be reduced to two points per pixel column without losing peaks.
+class MinMaxPyramid {
+public:
+    MinMaxPyramid() = default;
+    ~MinMaxPyramid() = default;
+
+    void build(const std::vector<double>& samples, double startX, double dx);
+    void clear();
+
+    bool isEmpty() const { return levelMin_.empty(); }
+    size_t getSampleCount() const { return levelMin_.empty() ? 0 : levelMin_[0].size(); }
+    double getStartX() const { return startX_; }
+    double getEndX() const { return startX_ + (getSampleCount() > 0 ? (getSampleCount() - 1) * dx_ : 0.0); }
+    double getSpacing() const { return dx_; }
+
+    // Extrema of the samples whose x lies in [x0, x1]; false if none do
+    bool findRange(double x0, double x1, double& minY, double& maxY) const;
+
+    // Reduce [x0, x1] to at most 2 * columns points (min and max per column).
+    // Ranges with fewer than 2 * columns samples are returned as raw samples.
+    void decimate(double x0, double x1, size_t columns, std::vector<double>& xOut, std::vector<double>& yOut) const;
+
+private:
+    // Extrema of sample indices [first, last)
+    void findIndexRange(size_t first, size_t last, double& minY, double& maxY) const;
+    bool toIndexRange(double x0, double x1, size_t& first, size_t& last) const;
+
+    std::vector<std::vector<double>> levelMin_;
+    std::vector<std::vector<double>> levelMax_;
+    double startX_ = 0.0;
+    double dx_ = 1.0;
+};
+
+#endif // MIN_MAX_PYRAMID_H
@@ -0,0 +1,36 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+
+// Runs job(index) for every index in [0, count) on up to numThreads threads
+// (0 = hardware concurrency). Indices are interleaved across the workers so
+// cheap and expensive ranges are balanced; with one worker the calling thread
+// does all the work.
+template <typename Job>
+void parallelFor(size_t count, unsigned int numThreads, Job&& job) {
+    if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t numWorkers = std::min<size_t>(numThreads, count);
+
+    if (numWorkers <= 1) {
+        for (size_t i = 0; i < count; ++i) job(i);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(numWorkers);
+    for (size_t w = 0; w < numWorkers; ++w) {
+        workers.emplace_back([&job, w, numWorkers, count]() {
+            for (size_t i = w; i < count; i += numWorkers) job(i);
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif // PARALLEL_FOR_H
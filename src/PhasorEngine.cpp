@@ -0,0 +1,127 @@
+#include "PhasorEngine.h"
+#include <cmath>
+#include <algorithm>
+
+void PhasorEngine::addComponent(const PhasorComponent& component) {
+    components_.push_back(component);
+}
+
+void PhasorEngine::addWave(const WaveFunction& wave, int maxHarmonics) {
+    double amplitude = wave.getAmplitude();
+    double frequency = wave.getFrequency();
+    double phase = wave.getPhase() * Physics::DEG_TO_RAD;
+    int harmonics = std::max(1, maxHarmonics);
+
+    switch (wave.getType()) {
+        case WaveType::COSINE:
+            // cos(θ) = sin(θ + π/2)
+            components_.push_back({amplitude, frequency, phase + Physics::PI / 2.0});
+            break;
+        case WaveType::SQUARE:
+            // (4A/π) Σ sin(kθ)/k, k odd
+            for (int k = 1; k <= harmonics; k += 2) {
+                components_.push_back({4.0 * amplitude / (Physics::PI * k), k * frequency, k * phase});
+            }
+            break;
+        case WaveType::TRIANGULAR:
+            // (8A/π²) Σ (-1)^((k-1)/2) sin(kθ)/k², k odd
+            for (int k = 1; k <= harmonics; k += 2) {
+                double sign = ((k - 1) / 2) % 2 == 0 ? 0.0 : Physics::PI;
+                components_.push_back({8.0 * amplitude / (Physics::PI * Physics::PI * k * k), k * frequency, k * phase + sign});
+            }
+            break;
+        case WaveType::SAWTOOTH:
+            // -(2A/π) Σ sin(kθ)/k
+            for (int k = 1; k <= harmonics; ++k) {
+                components_.push_back({2.0 * amplitude / (Physics::PI * k), k * frequency, k * phase + Physics::PI});
+            }
+            break;
+        case WaveType::SINUSOIDAL:
+        default:
+            components_.push_back({amplitude, frequency, phase});
+            break;
+    }
+}
+
+void PhasorEngine::addWaves(const std::vector<const WaveFunction*>& waves, int maxHarmonics) {
+    for (const auto* wave : waves) {
+        if (wave) addWave(*wave, maxHarmonics);
+    }
+}
+
+void PhasorEngine::clear() {
+    components_.clear();
+}
+
+double PhasorEngine::getCarrierFrequency() const {
+    double weightedSum = 0.0;
+    double totalAmplitude = 0.0;
+
+    for (const auto& component : components_) {
+        weightedSum += component.amplitude * component.frequency;
+        totalAmplitude += component.amplitude;
+    }
+
+    return totalAmplitude > 0.0 ? weightedSum / totalAmplitude : 0.0;
+}
+
+double PhasorEngine::evaluateEnvelope(double t) const {
+    double envelope = 0.0;
+    calculateEnvelope(t, 0.0, 1, &envelope);
+    return envelope;
+}
+
+std::vector<double> PhasorEngine::calculateEnvelope(double duration, double sampleRate, double startTime) const {
+    if (sampleRate <= 0.0 || duration <= 0.0) return {};
+
+    std::vector<double> envelope(static_cast<size_t>(duration * sampleRate));
+    calculateEnvelope(startTime, 1.0 / sampleRate, envelope.size(), envelope.data());
+    return envelope;
+}
+
+void PhasorEngine::calculateEnvelope(double startTime, double dt, size_t numSamples, double* output) const {
+    size_t n = components_.size();
+
+    if (n == 0) {
+        std::fill(output, output + numSamples, 0.0);
+        return;
+    }
+
+    double carrier = getCarrierFrequency();
+
+    // Structure-of-arrays so the per-sample loops over components vectorize
+    std::vector<double> re(n), im(n), stepRe(n), stepIm(n), offset(n);
+    for (size_t i = 0; i < n; ++i) {
+        offset[i] = Physics::TWO_PI * (components_[i].frequency - carrier);
+        stepRe[i] = std::cos(offset[i] * dt);
+        stepIm[i] = std::sin(offset[i] * dt);
+    }
+
+    for (size_t blockStart = 0; blockStart < numSamples; blockStart += RESYNC_INTERVAL) {
+        size_t blockEnd = std::min(blockStart + RESYNC_INTERVAL, numSamples);
+        double t0 = startTime + blockStart * dt;
+
+        // Exact phasors at the start of each block keep rotation drift bounded
+        for (size_t i = 0; i < n; ++i) {
+            double angle = offset[i] * t0 + components_[i].phase;
+            re[i] = components_[i].amplitude * std::cos(angle);
+            im[i] = components_[i].amplitude * std::sin(angle);
+        }
+
+        for (size_t s = blockStart; s < blockEnd; ++s) {
+            double sumRe = 0.0;
+            double sumIm = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                sumRe += re[i];
+                sumIm += im[i];
+            }
+            output[s] = std::sqrt(sumRe * sumRe + sumIm * sumIm);
+
+            for (size_t i = 0; i < n; ++i) {
+                double rotatedRe = re[i] * stepRe[i] - im[i] * stepIm[i];
+                im[i] = re[i] * stepIm[i] + im[i] * stepRe[i];
+                re[i] = rotatedRe;
+            }
+        }
+    }
+}
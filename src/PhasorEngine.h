@@ -0,0 +1,45 @@
+#ifndef PHASOR_ENGINE_H
+#define PHASOR_ENGINE_H
+
+#include "WaveFunction.h"
+#include <vector>
+
+// One sinusoidal component: amplitude * sin(2π * frequency * t + phase), phase in radians
+struct PhasorComponent {
+    double amplitude;
+    double frequency;
+    double phase;
+};
+
+class PhasorEngine {
+public:
+    PhasorEngine() = default;
+    ~PhasorEngine() = default;
+
+    // Component management; non-sinusoidal waves are expanded into their
+    // Fourier series up to maxHarmonics
+    void addComponent(const PhasorComponent& component);
+    void addWave(const WaveFunction& wave, int maxHarmonics = DEFAULT_HARMONICS);
+    void addWaves(const std::vector<const WaveFunction*>& waves, int maxHarmonics = DEFAULT_HARMONICS);
+    void clear();
+    size_t getComponentCount() const { return components_.size(); }
+    const std::vector<PhasorComponent>& getComponents() const { return components_; }
+
+    // Amplitude-weighted mean frequency; phasors are summed relative to it
+    double getCarrierFrequency() const;
+
+    // Exact envelope |Σ A_i exp(i(2π(f_i - fc)t + φ_i))| of the superposition
+    double evaluateEnvelope(double t) const;
+    std::vector<double> calculateEnvelope(double duration, double sampleRate, double startTime = 0.0) const;
+    void calculateEnvelope(double startTime, double dt, size_t numSamples, double* output) const;
+
+    static constexpr int DEFAULT_HARMONICS = 15;
+
+private:
+    std::vector<PhasorComponent> components_;
+
+    // Phasors are advanced by rotation and re-seeded exactly every block
+    static constexpr size_t RESYNC_INTERVAL = 256;
+};
+
+#endif // PHASOR_ENGINE_H
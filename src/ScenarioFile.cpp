@@ -0,0 +1,264 @@
+#include "ScenarioFile.h"
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <charconv>
+#include <string_view>
+#include <algorithm>
+
+namespace {
+
+struct Keyword {
+    const char* name;
+    int value;
+};
+
+// The first name of each value is the one save() writes
+const Keyword WAVE_TYPES[] = {
+    {"sine", static_cast<int>(WaveType::SINUSOIDAL)},
+    {"sin", static_cast<int>(WaveType::SINUSOIDAL)},
+    {"cosine", static_cast<int>(WaveType::COSINE)},
+    {"cos", static_cast<int>(WaveType::COSINE)},
+    {"square", static_cast<int>(WaveType::SQUARE)},
+    {"triangle", static_cast<int>(WaveType::TRIANGULAR)},
+    {"tri", static_cast<int>(WaveType::TRIANGULAR)},
+    {"sawtooth", static_cast<int>(WaveType::SAWTOOTH)},
+    {"saw", static_cast<int>(WaveType::SAWTOOTH)}
+};
+
+const Keyword ANALYSIS_STEPS[] = {
+    {"spectrum", static_cast<int>(AnalysisStep::SPECTRUM)},
+    {"beats", static_cast<int>(AnalysisStep::BEATS)},
+    {"interference", static_cast<int>(AnalysisStep::INTERFERENCE)},
+    {"phenomenon", static_cast<int>(AnalysisStep::PHENOMENON)},
+    {"energy", static_cast<int>(AnalysisStep::ENERGY)},
+    {"statistics", static_cast<int>(AnalysisStep::STATISTICS)}
+};
+
+template <size_t N>
+bool lookup(const Keyword (&table)[N], std::string_view name, int& value) {
+    for (const Keyword& keyword : table) {
+        if (name == keyword.name) {
+            value = keyword.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <size_t N>
+const char* nameOf(const Keyword (&table)[N], int value) {
+    for (const Keyword& keyword : table) {
+        if (keyword.value == value) return keyword.name;
+    }
+    return table[0].name;
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Next field before lineEnd; empty at the end of the line or at a comment
+std::string_view nextField(const char*& pos, const char* lineEnd) {
+    while (pos < lineEnd && isBlank(*pos)) ++pos;
+    if (pos == lineEnd || *pos == '#') {
+        pos = lineEnd;
+        return {};
+    }
+
+    const char* start = pos;
+    while (pos < lineEnd && !isBlank(*pos) && *pos != '#') ++pos;
+    return {start, static_cast<size_t>(pos - start)};
+}
+
+// std::from_chars parses without locales or allocation
+bool toNumber(std::string_view field, double& value) {
+    if (field.empty()) return false;
+    const char* last = field.data() + field.size();
+    auto result = std::from_chars(field.data(), last, value);
+    return result.ec == std::errc() && result.ptr == last && std::isfinite(value);
+}
+
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    out.push_back(' ');
+    out.append(buffer, end);
+}
+
+}
+
+bool ScenarioFile::fail(size_t line, const std::string& message) {
+    errorLine_ = line;
+    error_ = line ? "line " + std::to_string(line) + ": " + message : message;
+    return false;
+}
+
+bool ScenarioFile::load(const std::string& path, Scenario& scenario) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return fail(0, "cannot open " + path);
+
+    // One read of the whole file; the parser then works on the buffer in place
+    std::string text;
+    bool read = std::fseek(file, 0, SEEK_END) == 0;
+    long size = read ? std::ftell(file) : -1;
+    if (size >= 0 && std::fseek(file, 0, SEEK_SET) == 0) {
+        text.resize(static_cast<size_t>(size));
+        read = std::fread(&text[0], 1, text.size(), file) == text.size();
+    } else {
+        read = false;
+    }
+    std::fclose(file);
+
+    if (!read) return fail(0, "cannot read " + path);
+    return parse(text.data(), text.size(), scenario);
+}
+
+bool ScenarioFile::parse(const char* text, size_t size, Scenario& scenario) {
+    error_.clear();
+    errorLine_ = 0;
+
+    // Waves are one per line, so the line count bounds them and the list
+    // never has to grow while parsing
+    const char* end = text + size;
+    Scenario result;
+    result.waves.reserve(std::count(text, end, '\n') + 1);
+
+    size_t line = 0;
+    for (const char* pos = text; pos < end; ) {
+        ++line;
+        const char* lineEnd = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+        if (!lineEnd) lineEnd = end;
+        const char* next = lineEnd < end ? lineEnd + 1 : end;
+
+        std::string_view keyword = nextField(pos, lineEnd);
+        if (keyword.empty()) {
+            pos = next;
+            continue;
+        }
+
+        if (keyword == "wave") {
+            std::string_view typeField = nextField(pos, lineEnd);
+            int type;
+            if (!lookup(WAVE_TYPES, typeField, type)) {
+                return fail(line, typeField.empty() ? "wave needs a type" : "unknown wave type '" + std::string(typeField) + "'");
+            }
+
+            WaveSpec wave;
+            wave.type = static_cast<WaveType>(type);
+            if (!toNumber(nextField(pos, lineEnd), wave.amplitude) ||
+                !toNumber(nextField(pos, lineEnd), wave.frequency)) {
+                return fail(line, "wave needs a numeric amplitude and frequency");
+            }
+            if (wave.frequency <= 0.0) return fail(line, "wave frequency must be positive");
+
+            std::string_view phase = nextField(pos, lineEnd);
+            if (!phase.empty() && !toNumber(phase, wave.phase)) return fail(line, "invalid wave phase");
+
+            result.waves.push_back(wave);
+        } else if (keyword == "velocity") {
+            if (!toNumber(nextField(pos, lineEnd), result.velocity) || result.velocity <= 0.0) {
+                return fail(line, "velocity must be a positive number");
+            }
+        } else if (keyword == "sampling") {
+            if (!toNumber(nextField(pos, lineEnd), result.sampleRate) ||
+                !toNumber(nextField(pos, lineEnd), result.duration) ||
+                result.sampleRate <= 0.0 || result.duration <= 0.0) {
+                return fail(line, "sampling needs a positive rate and duration");
+            }
+
+            std::string_view position = nextField(pos, lineEnd);
+            if (!position.empty() && !toNumber(position, result.position)) return fail(line, "invalid sampling position");
+        } else if (keyword == "analyze") {
+            size_t before = result.analysis.size();
+            for (std::string_view field = nextField(pos, lineEnd); !field.empty(); field = nextField(pos, lineEnd)) {
+                int step;
+                if (!lookup(ANALYSIS_STEPS, field, step)) {
+                    return fail(line, "unknown analysis step '" + std::string(field) + "'");
+                }
+                result.analysis.push_back(static_cast<AnalysisStep>(step));
+            }
+            if (result.analysis.size() == before) return fail(line, "analyze needs at least one step");
+        } else if (keyword == "name") {
+            // The rest of the line, up to a comment, without surrounding blanks
+            std::string_view rest = nextField(pos, lineEnd);
+            const char* last = rest.data() + rest.size();
+            for (std::string_view field = rest; !field.empty(); field = nextField(pos, lineEnd)) {
+                last = field.data() + field.size();
+            }
+            result.name.assign(rest.data(), static_cast<size_t>(last - rest.data()));
+        } else {
+            return fail(line, "unknown directive '" + std::string(keyword) + "'");
+        }
+
+        if (!nextField(pos, lineEnd).empty()) return fail(line, "unexpected field after " + std::string(keyword));
+        pos = next;
+    }
+
+    scenario = std::move(result);
+    return true;
+}
+
+bool ScenarioFile::save(const std::string& path, const Scenario& scenario) {
+    std::string text;
+    text.reserve(64 + scenario.waves.size() * 48);
+
+    // A newline or '#' would end the name early when read back
+    if (!scenario.name.empty()) {
+        text += "name ";
+        text.append(scenario.name, 0, scenario.name.find_first_of("#\r\n"));
+        text += '\n';
+    }
+
+    text += "velocity";
+    appendNumber(text, scenario.velocity);
+    text += "\nsampling";
+    appendNumber(text, scenario.sampleRate);
+    appendNumber(text, scenario.duration);
+    appendNumber(text, scenario.position);
+    text += '\n';
+
+    if (!scenario.analysis.empty()) {
+        text += "analyze";
+        for (AnalysisStep step : scenario.analysis) {
+            text += ' ';
+            text += stepName(step);
+        }
+        text += '\n';
+    }
+
+    for (const WaveSpec& wave : scenario.waves) {
+        text += "wave ";
+        text += typeName(wave.type);
+        appendNumber(text, wave.amplitude);
+        appendNumber(text, wave.frequency);
+        appendNumber(text, wave.phase);
+        text += '\n';
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return fail(0, "cannot create " + path);
+
+    bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    bool closed = std::fclose(file) == 0;
+    if (!written || !closed) return fail(0, "cannot write " + path);
+    return true;
+}
+
+void ScenarioFile::apply(const Scenario& scenario, WaveEngine& engine) {
+    engine.clearWaves();
+    engine.setVelocity(scenario.velocity);
+    engine.reserveWaves(scenario.waves.size());
+
+    for (const WaveSpec& wave : scenario.waves) {
+        engine.addWave(WaveFunction::create(wave.type, wave.amplitude, wave.frequency, wave.phase));
+    }
+}
+
+const char* ScenarioFile::typeName(WaveType type) {
+    return nameOf(WAVE_TYPES, static_cast<int>(type));
+}
+
+const char* ScenarioFile::stepName(AnalysisStep step) {
+    return nameOf(ANALYSIS_STEPS, static_cast<int>(step));
+}
@@ -0,0 +1,67 @@
+#ifndef SCENARIO_FILE_H
+#define SCENARIO_FILE_H
+
+#include "WaveEngine.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+// Plain-text wave configuration, one directive per line; '#' starts a
+// comment and fields are separated by spaces or tabs:
+//   name <text>
+//   velocity <m/s>
+//   sampling <rate Hz> <duration s> [position m]
+//   wave <sine|cosine|square|triangle|sawtooth> <amplitude> <frequency Hz> [phase deg]
+//   analyze <step> [step ...]   steps: spectrum beats interference phenomenon energy statistics
+
+enum class AnalysisStep {
+    SPECTRUM,
+    BEATS,
+    INTERFERENCE,
+    PHENOMENON,
+    ENERGY,
+    STATISTICS
+};
+
+struct WaveSpec {
+    WaveType type = WaveType::SINUSOIDAL;
+    double amplitude = 1.0;
+    double frequency = 1.0;
+    double phase = 0.0;
+};
+
+struct Scenario {
+    std::string name;
+    double velocity = 1.0;
+    double sampleRate = 256.0;
+    double duration = 4.0;
+    double position = 0.0;
+    std::vector<WaveSpec> waves;
+    std::vector<AnalysisStep> analysis;     // In file order
+};
+
+class ScenarioFile {
+public:
+    // Both replace scenario on success; on failure getError() names the line
+    bool load(const std::string& path, Scenario& scenario);
+    bool parse(const char* text, size_t size, Scenario& scenario);
+
+    bool save(const std::string& path, const Scenario& scenario);
+
+    const std::string& getError() const { return error_; }
+    size_t getErrorLine() const { return errorLine_; }    // 0 if not tied to a line
+
+    // Replaces the engine's waves in one preallocated pass and sets its velocity
+    static void apply(const Scenario& scenario, WaveEngine& engine);
+
+    static const char* typeName(WaveType type);
+    static const char* stepName(AnalysisStep step);
+
+private:
+    bool fail(size_t line, const std::string& message);
+
+    std::string error_;
+    size_t errorLine_ = 0;
+};
+
+#endif // SCENARIO_FILE_H
@@ -0,0 +1,121 @@
+#include "SeriesExporter.h"
+#include <charconv>
+#include <vector>
+#include <algorithm>
+
+static_assert(sizeof(TimePoint) == 4 * sizeof(double), "TimePoint is written as four packed doubles");
+
+SeriesExporter::SeriesExporter()
+    : running_(false)
+    , cancelled_(false)
+    , samplesWritten_(0)
+    , totalSamples_(0)
+    , succeeded_(false) {}
+
+SeriesExporter::~SeriesExporter() {
+    cancel();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool SeriesExporter::start(const WaveEngine& engine, const std::string& path, const ExportSettings& settings) {
+    if (running_) return false;
+    if (worker_.joinable()) worker_.join();
+
+    succeeded_ = false;
+    error_.clear();
+    samplesWritten_ = 0;
+    totalSamples_ = settings.sampleRate > 0.0 && settings.duration > 0.0
+                    ? static_cast<size_t>(settings.duration * settings.sampleRate) : 0;
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error_ = "Cannot open " + path + " for writing";
+        return false;
+    }
+
+    cancelled_ = false;
+    running_ = true;
+    worker_ = std::thread(&SeriesExporter::run, this, engine.clone(), file, path, settings);
+    return true;
+}
+
+void SeriesExporter::cancel() {
+    cancelled_ = true;
+}
+
+double SeriesExporter::getProgress() const {
+    size_t total = totalSamples_;
+    return total > 0 ? static_cast<double>(samplesWritten_) / total : 1.0;
+}
+
+void SeriesExporter::run(std::unique_ptr<WaveEngine> engine, std::FILE* file, std::string path, ExportSettings settings) {
+    bool written = writeChunks(*engine, file, settings);
+    bool closed = std::fclose(file) == 0;
+
+    if (written && !closed) error_ = "Error while closing " + path;
+    succeeded_ = written && closed;
+
+    // Leave no truncated file behind
+    if (!succeeded_) std::remove(path.c_str());
+
+    running_ = false;
+}
+
+bool SeriesExporter::writeChunks(const WaveEngine& engine, std::FILE* file, const ExportSettings& settings) {
+    std::vector<TimePoint> points(CHUNK_SAMPLES);
+    std::vector<char> text;
+
+    if (settings.format == ExportFormat::CSV) {
+        text.resize(CHUNK_SAMPLES * MAX_ROW_CHARS);
+
+        static const char header[] = "time,amplitude,velocity,acceleration\n";
+        if (std::fwrite(header, 1, sizeof(header) - 1, file) != sizeof(header) - 1) {
+            error_ = "Write failed";
+            return false;
+        }
+    }
+
+    size_t total = totalSamples_;
+    for (size_t first = 0; first < total; first += CHUNK_SAMPLES) {
+        if (cancelled_) {
+            error_ = "Export cancelled";
+            return false;
+        }
+
+        size_t count = std::min(CHUNK_SAMPLES, total - first);
+        engine.generateDetailedTimeSeries(first, count, settings.sampleRate, settings.position, points.data());
+
+        const char* data = reinterpret_cast<const char*>(points.data());
+        size_t size = count * sizeof(TimePoint);
+
+        if (settings.format == ExportFormat::CSV) {
+            // std::to_chars gives the shortest round-trip form without locales or streams
+            char* out = text.data();
+            char* end = text.data() + text.size();
+            for (size_t i = 0; i < count; ++i) {
+                const TimePoint& point = points[i];
+                out = std::to_chars(out, end, point.time).ptr;
+                *out++ = ',';
+                out = std::to_chars(out, end, point.amplitude).ptr;
+                *out++ = ',';
+                out = std::to_chars(out, end, point.velocity).ptr;
+                *out++ = ',';
+                out = std::to_chars(out, end, point.acceleration).ptr;
+                *out++ = '\n';
+            }
+            data = text.data();
+            size = static_cast<size_t>(out - text.data());
+        }
+
+        if (std::fwrite(data, 1, size, file) != size) {
+            error_ = "Write failed";
+            return false;
+        }
+
+        samplesWritten_ = first + count;
+    }
+
+    return true;
+}
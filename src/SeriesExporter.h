@@ -0,0 +1,67 @@
+#ifndef SERIES_EXPORTER_H
+#define SERIES_EXPORTER_H
+
+#include "WaveEngine.h"
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <cstddef>
+
+enum class ExportFormat {
+    CSV,        // time,amplitude,velocity,acceleration rows after a header line
+    BINARY      // Headerless TimePoint records: four float64 in host byte order
+};
+
+struct ExportSettings {
+    ExportFormat format = ExportFormat::CSV;
+    double duration = 10.0;
+    double sampleRate = 1000.0;
+    double position = 0.0;
+};
+
+// Writes WaveEngine::generateDetailedTimeSeries output to a file on a
+// background thread. The series is generated and formatted in fixed chunks,
+// so memory use does not depend on the length of the export.
+class SeriesExporter {
+public:
+    SeriesExporter();
+    ~SeriesExporter();  // Cancels a running export and waits for it
+
+    SeriesExporter(const SeriesExporter&) = delete;
+    SeriesExporter& operator=(const SeriesExporter&) = delete;
+
+    // Snapshots the engine and starts writing; false if an export is already
+    // running or the file cannot be created
+    bool start(const WaveEngine& engine, const std::string& path, const ExportSettings& settings);
+    void cancel();
+
+    bool isRunning() const { return running_; }
+    size_t getSamplesWritten() const { return samplesWritten_; }
+    size_t getTotalSamples() const { return totalSamples_; }
+    double getProgress() const;
+
+    // Outcome of the last export, valid once isRunning() is false
+    bool succeeded() const { return succeeded_; }
+    const std::string& getError() const { return error_; }
+
+    static constexpr size_t CHUNK_SAMPLES = 65536;
+
+private:
+    void run(std::unique_ptr<WaveEngine> engine, std::FILE* file, std::string path, ExportSettings settings);
+    bool writeChunks(const WaveEngine& engine, std::FILE* file, const ExportSettings& settings);
+
+    std::thread worker_;
+    std::atomic<bool> running_;
+    std::atomic<bool> cancelled_;
+    std::atomic<size_t> samplesWritten_;
+    std::atomic<size_t> totalSamples_;
+    bool succeeded_;
+    std::string error_;
+
+    // Worst case for one CSV row: four shortest round-trip doubles plus separators
+    static constexpr size_t MAX_ROW_CHARS = 4 * 25;
+};
+
+#endif // SERIES_EXPORTER_H
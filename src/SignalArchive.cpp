@@ -0,0 +1,459 @@
+#include "SignalArchive.h"
+#include "ByteOrder.h"
+#include "ParallelFor.h"
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+const char MAGIC[8] = {'W', 'A', 'V', 'E', 'A', 'R', 'C', '\0'};
+
+const uint32_t ENCODING_RAW = 0;
+const uint32_t ENCODING_XOR_LZ = 1;
+
+// Neighbouring samples of a smooth signal share sign, exponent and leading
+// mantissa bits, so XORing each with its predecessor leaves mostly zero high
+// bytes. Plane p holds byte p of every word, which turns those into long runs.
+void encodePlanes(const double* samples, size_t count, unsigned char* planes) {
+    uint64_t previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t bits;
+        std::memcpy(&bits, &samples[i], sizeof(bits));
+        uint64_t delta = bits ^ previous;
+        previous = bits;
+        for (size_t p = 0; p < 8; ++p) {
+            planes[p * count + i] = static_cast<unsigned char>(delta >> (8 * p));
+        }
+    }
+}
+
+void decodePlanes(const unsigned char* planes, size_t count, double* samples) {
+    uint64_t previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t delta = 0;
+        for (size_t p = 0; p < 8; ++p) {
+            delta |= static_cast<uint64_t>(planes[p * count + i]) << (8 * p);
+        }
+        previous ^= delta;
+        std::memcpy(&samples[i], &previous, sizeof(previous));
+    }
+}
+
+// Byte-oriented LZ77 in the style of LZ4. Each sequence is a token (literal
+// count in the high nibble, match length - MIN_MATCH in the low one, 15
+// meaning "more bytes follow, 255 at a time"), the literals, then a 16-bit
+// little-endian offset. The final sequence carries literals only.
+const size_t MIN_MATCH = 4;
+const size_t LAST_LITERALS = 5;     // Keeps the tail out of matches
+const size_t MAX_OFFSET = 65535;
+const int HASH_BITS = 14;
+
+size_t lzBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+uint32_t read32(const unsigned char* in) {
+    uint32_t value;
+    std::memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+unsigned char* writeLength(unsigned char* out, size_t length) {
+    for (; length >= 255; length -= 255) *out++ = 255;
+    *out++ = static_cast<unsigned char>(length);
+    return out;
+}
+
+unsigned char* writeSequence(unsigned char* out, const unsigned char* literals, size_t literalCount,
+                             size_t offset, size_t matchLength) {
+    unsigned char* token = out++;
+    size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+    *token = static_cast<unsigned char>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15));
+
+    if (literalCount >= 15) out = writeLength(out, literalCount - 15);
+    std::memcpy(out, literals, literalCount);
+    out += literalCount;
+
+    if (matchLength) {
+        *out++ = static_cast<unsigned char>(offset);
+        *out++ = static_cast<unsigned char>(offset >> 8);
+        if (matchCode >= 15) out = writeLength(out, matchCode - 15);
+    }
+    return out;
+}
+
+// Returns the compressed size; output must hold lzBound(size) bytes
+size_t lzCompress(const unsigned char* input, size_t size, unsigned char* output) {
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);     // Position + 1, 0 when empty
+    unsigned char* out = output;
+    size_t anchor = 0;
+    size_t position = 0;
+    size_t misses = 0;
+
+    size_t matchLimit = size > LAST_LITERALS ? size - LAST_LITERALS : 0;
+    while (position + MIN_MATCH <= matchLimit) {
+        uint32_t sequence = read32(input + position);
+        uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        size_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(position + 1);
+
+        if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || read32(input + candidate - 1) != sequence) {
+            // Step faster through data that keeps failing to match
+            position += 1 + (misses++ >> 6);
+            continue;
+        }
+
+        size_t reference = candidate - 1;
+        size_t length = MIN_MATCH;
+        while (position + length < matchLimit && input[reference + length] == input[position + length]) ++length;
+
+        out = writeSequence(out, input + anchor, position - anchor, position - reference, length);
+        position += length;
+        anchor = position;
+        misses = 0;
+    }
+
+    out = writeSequence(out, input + anchor, size - anchor, 0, 0);
+    return static_cast<size_t>(out - output);
+}
+
+bool readLength(const unsigned char* input, size_t size, size_t& position, size_t& length) {
+    unsigned char byte;
+    do {
+        if (position >= size) return false;
+        byte = input[position++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// False unless the input decodes to exactly outputSize bytes
+bool lzDecompress(const unsigned char* input, size_t size, unsigned char* output, size_t outputSize) {
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < size) {
+        unsigned char token = input[in++];
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(input, size, in, literals)) return false;
+        if (literals > size - in || literals > outputSize - out) return false;
+        std::memcpy(output + out, input + in, literals);
+        in += literals;
+        out += literals;
+
+        if (in == size) break;
+
+        if (size - in < 2) return false;
+        size_t offset = input[in] | (static_cast<size_t>(input[in + 1]) << 8);
+        in += 2;
+
+        size_t length = token & 15;
+        if (length == 15 && !readLength(input, size, in, length)) return false;
+        length += MIN_MATCH;
+        if (offset == 0 || offset > out || length > outputSize - out) return false;
+
+        // An overlapping match repeats its period; each copy doubles the span
+        // that can be copied next
+        unsigned char* target = output + out;
+        const unsigned char* source = target - offset;
+        for (size_t remaining = length; remaining > 0;) {
+            size_t step = std::min<size_t>(static_cast<size_t>(target - source), remaining);
+            std::memcpy(target, source, step);
+            target += step;
+            remaining -= step;
+        }
+        out += length;
+    }
+
+    return out == outputSize;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// SignalArchiveWriter
+
+SignalArchiveWriter::~SignalArchiveWriter() {
+    if (file_) std::fclose(file_);
+}
+
+bool SignalArchiveWriter::open(const std::string& path, double sampleRate, double startTime, uint32_t chunkSamples) {
+    if (file_ || !ByteOrder::isLittleEndian() || sampleRate <= 0.0 || chunkSamples == 0 ||
+        chunkSamples > MAX_CHUNK_SAMPLES) return false;
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return false;
+
+    // The header is written by close(); until then the magic is blank
+    unsigned char header[SignalArchive::HEADER_SIZE] = {};
+    if (std::fwrite(header, 1, sizeof(header), file_) != sizeof(header)) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+
+    chunkSamples_ = chunkSamples;
+    sampleRate_ = sampleRate;
+    startTime_ = startTime;
+    sampleCount_ = 0;
+    offset_ = SignalArchive::HEADER_SIZE;
+    pending_.clear();
+    pending_.reserve(chunkSamples);
+    index_.clear();
+    return true;
+}
+
+bool SignalArchiveWriter::append(const double* samples, size_t count) {
+    if (!file_) return false;
+
+    while (count > 0) {
+        size_t take = std::min<size_t>(count, chunkSamples_ - pending_.size());
+        pending_.insert(pending_.end(), samples, samples + take);
+        samples += take;
+        count -= take;
+        sampleCount_ += take;
+
+        if (pending_.size() == chunkSamples_ && !flushChunk()) return false;
+    }
+    return true;
+}
+
+bool SignalArchiveWriter::flushChunk() {
+    size_t count = pending_.size();
+    size_t rawBytes = count * sizeof(double);
+
+    ArchiveChunk chunk;
+    chunk.offset = offset_;
+    chunk.sampleCount = static_cast<uint32_t>(count);
+    auto extrema = std::minmax_element(pending_.begin(), pending_.end());
+    chunk.minValue = static_cast<float>(*extrema.first);
+    chunk.maxValue = static_cast<float>(*extrema.second);
+
+    planes_.resize(rawBytes);
+    compressed_.resize(lzBound(rawBytes));
+    encodePlanes(pending_.data(), count, planes_.data());
+    size_t compressedBytes = lzCompress(planes_.data(), rawBytes, compressed_.data());
+
+    // Noise-like chunks can come out larger; keep those as they are
+    const void* payload;
+    if (compressedBytes < rawBytes) {
+        chunk.encoding = ENCODING_XOR_LZ;
+        chunk.storedSize = static_cast<uint32_t>(compressedBytes);
+        payload = compressed_.data();
+    } else {
+        chunk.encoding = ENCODING_RAW;
+        chunk.storedSize = static_cast<uint32_t>(rawBytes);
+        payload = pending_.data();
+    }
+
+    if (std::fwrite(payload, 1, chunk.storedSize, file_) != chunk.storedSize) return false;
+
+    offset_ += chunk.storedSize;
+    index_.push_back(chunk);
+    pending_.clear();
+    return true;
+}
+
+bool SignalArchiveWriter::close() {
+    if (!file_) return false;
+
+    bool written = pending_.empty() || flushChunk();
+
+    std::vector<unsigned char> index(index_.size() * SignalArchive::INDEX_ENTRY_SIZE, 0);
+    for (size_t i = 0; i < index_.size(); ++i) {
+        unsigned char* entry = index.data() + i * SignalArchive::INDEX_ENTRY_SIZE;
+        ByteOrder::putU64(entry, index_[i].offset);
+        ByteOrder::putU32(entry + 8, index_[i].storedSize);
+        ByteOrder::putU32(entry + 12, index_[i].sampleCount);
+        ByteOrder::putF32(entry + 16, index_[i].minValue);
+        ByteOrder::putF32(entry + 20, index_[i].maxValue);
+        ByteOrder::putU32(entry + 24, index_[i].encoding);
+    }
+    written = written && std::fwrite(index.data(), 1, index.size(), file_) == index.size();
+
+    unsigned char header[SignalArchive::HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    ByteOrder::putU32(header + 8, SignalArchive::VERSION);
+    ByteOrder::putU32(header + 12, chunkSamples_);
+    ByteOrder::putU64(header + 16, sampleCount_);
+    ByteOrder::putF64(header + 24, sampleRate_);
+    ByteOrder::putF64(header + 32, startTime_);
+    ByteOrder::putU64(header + 40, offset_);
+    ByteOrder::putU32(header + 48, static_cast<uint32_t>(index_.size()));
+    written = written && std::fseek(file_, 0, SEEK_SET) == 0 &&
+              std::fwrite(header, 1, sizeof(header), file_) == sizeof(header);
+
+    bool closed = std::fclose(file_) == 0;
+    file_ = nullptr;
+
+    return written && closed;
+}
+
+bool SignalArchiveWriter::writeEngine(const WaveEngine& engine, const std::string& path, double duration, double sampleRate) {
+    if (duration <= 0.0 || sampleRate <= 0.0) return false;
+
+    SignalArchiveWriter writer;
+    if (!writer.open(path, sampleRate)) return false;
+
+    size_t sampleCount = static_cast<size_t>(duration * sampleRate);
+    std::vector<double> block(DEFAULT_CHUNK_SAMPLES);
+    double dt = 1.0 / sampleRate;
+
+    for (size_t first = 0; first < sampleCount; first += block.size()) {
+        size_t count = std::min(block.size(), sampleCount - first);
+        for (size_t i = 0; i < count; ++i) {
+            block[i] = engine.evaluateSuperposition(0.0, (first + i) * dt);
+        }
+        if (!writer.append(block.data(), count)) return false;
+    }
+
+    return writer.close();
+}
+
+// ---------------------------------------------------------------------------
+// SignalArchive
+
+SignalArchive::~SignalArchive() {
+    close();
+}
+
+bool SignalArchive::open(const std::string& path) {
+    close();
+    if (!ByteOrder::isLittleEndian() || !mapping_.open(path, HEADER_SIZE)) return false;
+
+    const unsigned char* bytes = mapping_.data();
+    size_t size = mapping_.size();
+    uint64_t indexOffset = ByteOrder::getU64(bytes + 40);
+    uint32_t chunkCount = ByteOrder::getU32(bytes + 48);
+
+    if (std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || ByteOrder::getU32(bytes + 8) != VERSION ||
+        indexOffset < HEADER_SIZE || indexOffset > size ||
+        static_cast<uint64_t>(chunkCount) * INDEX_ENTRY_SIZE > size - indexOffset) {
+        close();
+        return false;
+    }
+
+    chunkSamples_ = ByteOrder::getU32(bytes + 12);
+    sampleCount_ = ByteOrder::getU64(bytes + 16);
+    sampleRate_ = ByteOrder::getF64(bytes + 24);
+    startTime_ = ByteOrder::getF64(bytes + 32);
+
+    // Every chunk but the last must be full so a sample index maps straight
+    // to its chunk, and every payload must lie between the header and index
+    uint64_t total = 0;
+    chunks_.resize(chunkCount);
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        const unsigned char* entry = bytes + indexOffset + i * INDEX_ENTRY_SIZE;
+        ArchiveChunk& chunk = chunks_[i];
+        chunk.offset = ByteOrder::getU64(entry);
+        chunk.storedSize = ByteOrder::getU32(entry + 8);
+        chunk.sampleCount = ByteOrder::getU32(entry + 12);
+        chunk.minValue = ByteOrder::getF32(entry + 16);
+        chunk.maxValue = ByteOrder::getF32(entry + 20);
+        chunk.encoding = ByteOrder::getU32(entry + 24);
+
+        bool valid = chunk.offset >= HEADER_SIZE && chunk.offset <= indexOffset &&
+                     chunk.storedSize <= indexOffset - chunk.offset &&
+                     (chunk.sampleCount == chunkSamples_ || (i + 1 == chunkCount && chunk.sampleCount <= chunkSamples_)) &&
+                     (chunk.encoding == ENCODING_XOR_LZ ||
+                      (chunk.encoding == ENCODING_RAW && chunk.storedSize == chunk.sampleCount * sizeof(double)));
+        if (!valid) {
+            close();
+            return false;
+        }
+        total += chunk.sampleCount;
+    }
+
+    if (total != sampleCount_ || (chunkCount > 0 && chunkSamples_ == 0) ||
+        chunkSamples_ > SignalArchiveWriter::MAX_CHUNK_SAMPLES) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void SignalArchive::close() {
+    mapping_.close();
+    chunks_.clear();
+    sampleCount_ = 0;
+    sampleRate_ = 0.0;
+    startTime_ = 0.0;
+    chunkSamples_ = 0;
+}
+
+bool SignalArchive::decodeChunk(size_t chunk, double* output) const {
+    const ArchiveChunk& entry = chunks_[chunk];
+    const unsigned char* payload = mapping_.data() + entry.offset;
+
+    if (entry.encoding == ENCODING_RAW) {
+        std::memcpy(output, payload, entry.storedSize);
+        return true;
+    }
+
+    std::vector<unsigned char> planes(entry.sampleCount * sizeof(double));
+    if (!lzDecompress(payload, entry.storedSize, planes.data(), planes.size())) return false;
+
+    decodePlanes(planes.data(), entry.sampleCount, output);
+    return true;
+}
+
+size_t SignalArchive::readSamples(uint64_t first, size_t count, double* output, unsigned int numThreads) const {
+    if (!mapping_.isOpen() || first >= sampleCount_ || count == 0) return 0;
+    count = static_cast<size_t>(std::min<uint64_t>(count, sampleCount_ - first));
+
+    uint64_t last = first + count;
+    size_t firstChunk = static_cast<size_t>(first / chunkSamples_);
+    size_t lastChunk = static_cast<size_t>((last - 1) / chunkSamples_);
+    std::atomic<bool> corrupt(false);
+
+    parallelFor(lastChunk - firstChunk + 1, numThreads, [&](size_t task) {
+        size_t chunk = firstChunk + task;
+        uint64_t chunkStart = static_cast<uint64_t>(chunk) * chunkSamples_;
+        uint64_t chunkEnd = chunkStart + chunks_[chunk].sampleCount;
+
+        // Chunks wholly inside the range decode in place; the ends go through a scratch buffer
+        bool ok;
+        if (chunkStart >= first && chunkEnd <= last) {
+            ok = decodeChunk(chunk, output + (chunkStart - first));
+        } else {
+            std::vector<double> scratch(chunks_[chunk].sampleCount);
+            ok = decodeChunk(chunk, scratch.data());
+            if (ok) {
+                uint64_t from = std::max(first, chunkStart);
+                uint64_t to = std::min(last, chunkEnd);
+                std::copy(scratch.begin() + (from - chunkStart), scratch.begin() + (to - chunkStart),
+                          output + (from - first));
+            }
+        }
+        if (!ok) corrupt = true;
+    });
+
+    return corrupt ? 0 : count;
+}
+
+std::vector<double> SignalArchive::readTimeRange(double startTime, double endTime, uint64_t* firstSample,
+                                                 unsigned int numThreads) const {
+    std::vector<double> samples;
+    if (firstSample) *firstSample = 0;
+    if (!mapping_.isOpen() || sampleCount_ == 0 || endTime < startTime) return samples;
+
+    double first = std::ceil((startTime - startTime_) * sampleRate_);
+    double last = std::floor((endTime - startTime_) * sampleRate_);
+    first = std::max(first, 0.0);
+    last = std::min(last, static_cast<double>(sampleCount_ - 1));
+    if (first > last) return samples;
+
+    uint64_t firstIndex = static_cast<uint64_t>(first);
+    samples.resize(static_cast<size_t>(last - first) + 1);
+    if (readSamples(firstIndex, samples.size(), samples.data(), numThreads) != samples.size()) {
+        samples.clear();
+        return samples;
+    }
+
+    if (firstSample) *firstSample = firstIndex;
+    return samples;
+}
@@ -0,0 +1,117 @@
+#ifndef SIGNAL_ARCHIVE_H
+#define SIGNAL_ARCHIVE_H
+
+#include "WaveEngine.h"
+#include "MappedFile.h"
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+// Compressed single-channel capture, stored in chunks of chunkSamples
+// float64 samples. Each chunk XORs every sample's bits with the previous
+// sample's, splits the result into byte planes and compresses it with a small
+// LZ77 codec; chunks that do not shrink are stored raw. An index at the end
+// of the file (offset, size, sample count and extrema per chunk) lets readers
+// decode only the chunks that cover a requested range.
+//
+// Layout, little-endian: 64-byte header (magic "WAVEARC\0", uint32 version,
+// uint32 chunk samples, uint64 sample count, float64 sample rate, float64
+// start time, uint64 index offset, uint32 chunk count, 12 reserved bytes),
+// the chunk payloads, then one 32-byte index entry per chunk.
+
+struct ArchiveChunk {
+    uint64_t offset;
+    uint32_t storedSize;
+    uint32_t sampleCount;
+    float minValue;         // Extrema, for overviews that need no decoding
+    float maxValue;
+    uint32_t encoding;      // 0 = raw, 1 = XOR + byte planes + LZ
+};
+
+class SignalArchiveWriter {
+public:
+    SignalArchiveWriter() = default;
+    ~SignalArchiveWriter();  // Abandons an unfinished file
+
+    SignalArchiveWriter(const SignalArchiveWriter&) = delete;
+    SignalArchiveWriter& operator=(const SignalArchiveWriter&) = delete;
+
+    // Fails unless 0 < chunkSamples <= MAX_CHUNK_SAMPLES
+    bool open(const std::string& path, double sampleRate, double startTime = 0.0,
+              uint32_t chunkSamples = DEFAULT_CHUNK_SAMPLES);
+    bool append(const double* samples, size_t count);
+    bool close();           // Flushes the last partial chunk and writes the index
+
+    uint64_t getSampleCount() const { return sampleCount_; }
+    uint64_t getStoredBytes() const { return offset_; }
+
+    // Superposition at x = 0
+    static bool writeEngine(const WaveEngine& engine, const std::string& path, double duration, double sampleRate);
+
+    static constexpr uint32_t DEFAULT_CHUNK_SAMPLES = 65536;
+
+    // Largest chunk whose bytes fit the 32-bit stored size and LZ positions
+    static constexpr uint32_t MAX_CHUNK_SAMPLES = UINT32_MAX / sizeof(double);
+
+private:
+    bool flushChunk();
+
+    std::FILE* file_ = nullptr;
+    uint32_t chunkSamples_ = DEFAULT_CHUNK_SAMPLES;
+    double sampleRate_ = 0.0;
+    double startTime_ = 0.0;
+    uint64_t sampleCount_ = 0;
+    uint64_t offset_ = 0;
+    std::vector<double> pending_;
+    std::vector<ArchiveChunk> index_;
+    std::vector<unsigned char> planes_;
+    std::vector<unsigned char> compressed_;
+};
+
+class SignalArchive {
+public:
+    SignalArchive() = default;
+    ~SignalArchive();
+
+    SignalArchive(const SignalArchive&) = delete;
+    SignalArchive& operator=(const SignalArchive&) = delete;
+
+    // Maps the file and loads the index; payloads are decoded on demand
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping_.isOpen(); }
+
+    uint64_t getSampleCount() const { return sampleCount_; }
+    double getSampleRate() const { return sampleRate_; }
+    double getStartTime() const { return startTime_; }
+    uint32_t getChunkSamples() const { return chunkSamples_; }
+    const std::vector<ArchiveChunk>& getChunks() const { return chunks_; }
+
+    // Decodes samples [first, first + count), one chunk per task across
+    // numThreads (0 = hardware concurrency); returns the number decoded,
+    // or 0 if a chunk is corrupt
+    size_t readSamples(uint64_t first, size_t count, double* output, unsigned int numThreads = 0) const;
+
+    // Samples whose time lies in [startTime, endTime]; firstSample receives
+    // the index of output[0]
+    std::vector<double> readTimeRange(double startTime, double endTime, uint64_t* firstSample = nullptr,
+                                      unsigned int numThreads = 0) const;
+
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 64;
+    static constexpr size_t INDEX_ENTRY_SIZE = 32;
+
+private:
+    bool decodeChunk(size_t chunk, double* output) const;
+
+    MappedFile mapping_;
+    std::vector<ArchiveChunk> chunks_;
+    uint64_t sampleCount_ = 0;
+    double sampleRate_ = 0.0;
+    double startTime_ = 0.0;
+    uint32_t chunkSamples_ = 0;
+};
+
+#endif // SIGNAL_ARCHIVE_H
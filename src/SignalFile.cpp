@@ -0,0 +1,251 @@
+#include "SignalFile.h"
+#include "ByteOrder.h"
+#include <cstring>
+#include <algorithm>
+#include <sys/types.h>
+
+namespace {
+
+const char MAGIC[8] = {'W', 'A', 'V', 'E', 'S', 'I', 'G', '\0'};
+
+size_t sampleSize(SampleType type) {
+    return type == SampleType::FLOAT32 ? sizeof(float) : sizeof(double);
+}
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// SignalFileWriter
+
+SignalFileWriter::~SignalFileWriter() {
+    if (file_) std::fclose(file_);
+}
+
+bool SignalFileWriter::open(const std::string& path, const std::vector<SignalChannel>& channels,
+                            size_t sampleCount, double sampleRate, double startTime) {
+    if (file_ || !ByteOrder::isLittleEndian() || sampleRate <= 0.0) return false;
+
+    size_t tableEnd = SignalFile::HEADER_SIZE + channels.size() * SignalFile::CHANNEL_ENTRY_SIZE;
+    std::vector<unsigned char> header(tableEnd, 0);
+
+    // Lay the columns out back to back, each on an aligned boundary
+    columns_.clear();
+    uint64_t offset = alignUp(tableEnd, SignalFile::COLUMN_ALIGNMENT);
+    for (size_t i = 0; i < channels.size(); ++i) {
+        uint64_t bytes = static_cast<uint64_t>(sampleCount) * sampleSize(channels[i].type);
+        unsigned char* entry = header.data() + SignalFile::HEADER_SIZE + i * SignalFile::CHANNEL_ENTRY_SIZE;
+
+        std::memcpy(entry, channels[i].name.data(), std::min(channels[i].name.size(), SignalFile::CHANNEL_NAME_SIZE - 1));
+        ByteOrder::putU32(entry + 40, static_cast<uint32_t>(channels[i].type));
+        ByteOrder::putU64(entry + 48, offset);
+        ByteOrder::putU64(entry + 56, bytes);
+
+        columns_.push_back({channels[i].type, offset, 0});
+        offset = alignUp(offset + bytes, SignalFile::COLUMN_ALIGNMENT);
+    }
+
+    std::memcpy(header.data(), MAGIC, sizeof(MAGIC));
+    ByteOrder::putU32(header.data() + 8, SignalFile::VERSION);
+    ByteOrder::putU32(header.data() + 12, static_cast<uint32_t>(channels.size()));
+    ByteOrder::putU64(header.data() + 16, sampleCount);
+    ByteOrder::putF64(header.data() + 24, sampleRate);
+    ByteOrder::putF64(header.data() + 32, startTime);
+    ByteOrder::putU64(header.data() + 40, columns_.empty() ? tableEnd : columns_.front().offset);
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return false;
+
+    if (std::fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+
+    sampleCount_ = sampleCount;
+    return true;
+}
+
+bool SignalFileWriter::writeSamples(size_t channel, const double* samples, size_t count) {
+    if (!file_ || channel >= columns_.size()) return false;
+
+    Column& column = columns_[channel];
+    if (count > sampleCount_ - column.written) return false;
+
+    size_t size = sampleSize(column.type);
+    // fseeko: columns of multi-GB captures lie beyond what a 32-bit long can address
+    if (fseeko(file_, static_cast<off_t>(column.offset + column.written * size), SEEK_SET) != 0) return false;
+
+    bool written;
+    if (column.type == SampleType::FLOAT32) {
+        floatBuffer_.assign(samples, samples + count);
+        written = std::fwrite(floatBuffer_.data(), sizeof(float), count, file_) == count;
+    } else {
+        written = std::fwrite(samples, sizeof(double), count, file_) == count;
+    }
+
+    if (written) column.written += count;
+    return written;
+}
+
+bool SignalFileWriter::close() {
+    if (!file_) return false;
+
+    bool complete = std::all_of(columns_.begin(), columns_.end(),
+                                [this](const Column& column) { return column.written == sampleCount_; });
+    bool closed = std::fclose(file_) == 0;
+    file_ = nullptr;
+
+    return complete && closed;
+}
+
+bool SignalFileWriter::writeEngine(const WaveEngine& engine, const std::string& path, double duration,
+                                   double sampleRate, SampleType type, bool perWave) {
+    if (duration <= 0.0 || sampleRate <= 0.0) return false;
+
+    size_t numWaves = perWave ? engine.getWaveCount() : 0;
+    std::vector<SignalChannel> channels(1 + numWaves);
+    channels[0] = {"superposition", type};
+    for (size_t i = 0; i < numWaves; ++i) {
+        channels[i + 1] = {"wave" + std::to_string(i + 1), type};
+    }
+
+    size_t sampleCount = static_cast<size_t>(duration * sampleRate);
+    SignalFileWriter writer;
+    if (!writer.open(path, channels, sampleCount, sampleRate)) return false;
+
+    // One chunk of every column at a time; the per-wave samples sum to channel 0
+    std::vector<double> sum(CHUNK_SAMPLES);
+    std::vector<double> wave(CHUNK_SAMPLES);
+    double dt = 1.0 / sampleRate;
+
+    for (size_t first = 0; first < sampleCount; first += CHUNK_SAMPLES) {
+        size_t count = std::min(CHUNK_SAMPLES, sampleCount - first);
+
+        if (perWave) {
+            std::fill(sum.begin(), sum.begin() + count, 0.0);
+            for (size_t w = 0; w < numWaves; ++w) {
+                for (size_t i = 0; i < count; ++i) {
+                    wave[i] = engine.evaluateWave(w, 0.0, (first + i) * dt);
+                    sum[i] += wave[i];
+                }
+                if (!writer.writeSamples(w + 1, wave.data(), count)) return false;
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                sum[i] = engine.evaluateSuperposition(0.0, (first + i) * dt);
+            }
+        }
+
+        if (!writer.writeSamples(0, sum.data(), count)) return false;
+    }
+
+    return writer.close();
+}
+
+// ---------------------------------------------------------------------------
+// SignalFile
+
+SignalFile::~SignalFile() {
+    close();
+}
+
+bool SignalFile::open(const std::string& path) {
+    close();
+    if (!ByteOrder::isLittleEndian() || !mapping_.open(path, HEADER_SIZE)) return false;
+
+    const unsigned char* bytes = mapping_.data();
+    size_t size = mapping_.size();
+    uint32_t channelCount = ByteOrder::getU32(bytes + 12);
+    size_t tableEnd = HEADER_SIZE + static_cast<size_t>(channelCount) * CHANNEL_ENTRY_SIZE;
+
+    if (std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || ByteOrder::getU32(bytes + 8) != VERSION || tableEnd > size) {
+        close();
+        return false;
+    }
+
+    sampleCount_ = static_cast<size_t>(ByteOrder::getU64(bytes + 16));
+    sampleRate_ = ByteOrder::getF64(bytes + 24);
+    startTime_ = ByteOrder::getF64(bytes + 32);
+
+    for (uint32_t i = 0; i < channelCount; ++i) {
+        const unsigned char* entry = bytes + HEADER_SIZE + i * CHANNEL_ENTRY_SIZE;
+        uint32_t type = ByteOrder::getU32(entry + 40);
+        uint64_t offset = ByteOrder::getU64(entry + 48);
+        uint64_t columnBytes = ByteOrder::getU64(entry + 56);
+
+        // Reject anything that would read outside the mapping or misalign a sample
+        bool valid = type <= static_cast<uint32_t>(SampleType::FLOAT32);
+        size_t itemSize = valid ? sampleSize(static_cast<SampleType>(type)) : 1;
+        valid = valid && offset % itemSize == 0 && offset >= tableEnd && offset <= size &&
+                columnBytes <= size - offset && columnBytes / itemSize == sampleCount_;
+        if (!valid) {
+            close();
+            return false;
+        }
+
+        SignalChannel channel;
+        channel.name.assign(reinterpret_cast<const char*>(entry), strnlen(reinterpret_cast<const char*>(entry), CHANNEL_NAME_SIZE));
+        channel.type = static_cast<SampleType>(type);
+        channels_.push_back(channel);
+        columnOffsets_.push_back(offset);
+    }
+
+    return true;
+}
+
+void SignalFile::close() {
+    mapping_.close();
+    channels_.clear();
+    columnOffsets_.clear();
+    sampleCount_ = 0;
+    sampleRate_ = 0.0;
+    startTime_ = 0.0;
+}
+
+int SignalFile::findChannel(const std::string& name) const {
+    for (size_t i = 0; i < channels_.size(); ++i) {
+        if (channels_[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+const unsigned char* SignalFile::column(size_t channel) const {
+    return mapping_.data() + columnOffsets_[channel];
+}
+
+SampleSpan<double> SignalFile::getFloat64(size_t channel) const {
+    SampleSpan<double> span;
+    if (channel < channels_.size() && channels_[channel].type == SampleType::FLOAT64) {
+        span.data = reinterpret_cast<const double*>(column(channel));
+        span.size = sampleCount_;
+    }
+    return span;
+}
+
+SampleSpan<float> SignalFile::getFloat32(size_t channel) const {
+    SampleSpan<float> span;
+    if (channel < channels_.size() && channels_[channel].type == SampleType::FLOAT32) {
+        span.data = reinterpret_cast<const float*>(column(channel));
+        span.size = sampleCount_;
+    }
+    return span;
+}
+
+size_t SignalFile::readSamples(size_t channel, size_t first, size_t count, double* output) const {
+    if (channel >= channels_.size() || first >= sampleCount_) return 0;
+    count = std::min(count, sampleCount_ - first);
+
+    if (channels_[channel].type == SampleType::FLOAT32) {
+        const float* samples = getFloat32(channel).data + first;
+        std::copy(samples, samples + count, output);
+    } else {
+        const double* samples = getFloat64(channel).data + first;
+        std::copy(samples, samples + count, output);
+    }
+
+    return count;
+}
@@ -0,0 +1,124 @@
+#ifndef SIGNAL_FILE_H
+#define SIGNAL_FILE_H
+
+#include "WaveEngine.h"
+#include "MappedFile.h"
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+// Columnar capture format, all fields little-endian:
+//   header (64 bytes): magic "WAVESIG\0", uint32 version, uint32 channel
+//     count, uint64 sample count, float64 sample rate, float64 start time,
+//     uint64 offset of the first column, 16 reserved bytes
+//   one 64-byte entry per channel: name (40 bytes, NUL padded), uint32
+//     sample type, uint32 reserved, uint64 column offset, uint64 column bytes
+//   the columns, each starting on a COLUMN_ALIGNMENT boundary
+// Columns hold raw samples, so a mapped file is used in place.
+
+enum class SampleType : uint32_t {
+    FLOAT64 = 0,
+    FLOAT32 = 1
+};
+
+struct SignalChannel {
+    std::string name;
+    SampleType type = SampleType::FLOAT64;
+};
+
+// Read-only view of one column inside a mapped file
+template <typename T>
+struct SampleSpan {
+    const T* data = nullptr;
+    size_t size = 0;
+
+    bool empty() const { return size == 0; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    T operator[](size_t index) const { return data[index]; }
+};
+
+class SignalFileWriter {
+public:
+    SignalFileWriter() = default;
+    ~SignalFileWriter();  // Abandons an unfinished file
+
+    SignalFileWriter(const SignalFileWriter&) = delete;
+    SignalFileWriter& operator=(const SignalFileWriter&) = delete;
+
+    // Lays out every column for sampleCount samples and writes the header
+    bool open(const std::string& path, const std::vector<SignalChannel>& channels,
+              size_t sampleCount, double sampleRate, double startTime = 0.0);
+
+    // Appends the next count samples of one channel; channels fill independently
+    bool writeSamples(size_t channel, const double* samples, size_t count);
+
+    // False unless every column was written in full
+    bool close();
+
+    // Superposition in channel 0, then one channel per wave if perWave
+    static bool writeEngine(const WaveEngine& engine, const std::string& path, double duration,
+                            double sampleRate, SampleType type = SampleType::FLOAT64, bool perWave = true);
+
+    static constexpr size_t CHUNK_SAMPLES = 65536;
+
+private:
+    struct Column {
+        SampleType type;
+        uint64_t offset;
+        size_t written;
+    };
+
+    std::FILE* file_ = nullptr;
+    std::vector<Column> columns_;
+    size_t sampleCount_ = 0;
+    std::vector<float> floatBuffer_;
+};
+
+class SignalFile {
+public:
+    SignalFile() = default;
+    ~SignalFile();
+
+    SignalFile(const SignalFile&) = delete;
+    SignalFile& operator=(const SignalFile&) = delete;
+
+    // Maps the file read-only and validates the header and column bounds
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping_.isOpen(); }
+
+    size_t getChannelCount() const { return channels_.size(); }
+    const SignalChannel& getChannel(size_t index) const { return channels_[index]; }
+    int findChannel(const std::string& name) const;  // -1 if absent
+    size_t getSampleCount() const { return sampleCount_; }
+    double getSampleRate() const { return sampleRate_; }
+    double getStartTime() const { return startTime_; }
+
+    // Zero-copy columns; empty if the channel has another sample type
+    SampleSpan<double> getFloat64(size_t channel) const;
+    SampleSpan<float> getFloat32(size_t channel) const;
+
+    // Samples [first, first + count) of any column as doubles; returns the number copied
+    size_t readSamples(size_t channel, size_t first, size_t count, double* output) const;
+
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 64;
+    static constexpr size_t CHANNEL_ENTRY_SIZE = 64;
+    static constexpr size_t CHANNEL_NAME_SIZE = 40;
+    static constexpr size_t COLUMN_ALIGNMENT = 64;
+
+private:
+    const unsigned char* column(size_t channel) const;
+
+    MappedFile mapping_;
+    std::vector<SignalChannel> channels_;
+    std::vector<uint64_t> columnOffsets_;
+    size_t sampleCount_ = 0;
+    double sampleRate_ = 0.0;
+    double startTime_ = 0.0;
+};
+
+#endif // SIGNAL_FILE_H
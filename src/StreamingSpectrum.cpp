@@ -0,0 +1,92 @@
+#include "StreamingSpectrum.h"
+#include "PhysicsConstants.h"
+#include <cmath>
+#include <algorithm>
+
+StreamingSpectrum::StreamingSpectrum(size_t fftSize, double sampleRate)
+    : fftSize_(0)
+    , sampleRate_(sampleRate)
+    , writePos_(0)
+    , samplesPushed_(0)
+    , windowSum_(0.0)
+    , peakDecay_(0.995) {
+    configure(fftSize, sampleRate);
+}
+
+void StreamingSpectrum::configure(size_t fftSize, double sampleRate) {
+    size_t size = analyzer_.nextPowerOfTwo(std::max<size_t>(fftSize, 2));
+    sampleRate_ = sampleRate;
+
+    if (size != fftSize_) {
+        fftSize_ = size;
+        analyzer_.preparePlan(plan_, fftSize_ / 2);
+
+        history_.assign(fftSize_, 0.0);
+        frame_.assign(fftSize_, 0.0);
+        bins_.assign(fftSize_ / 2 + 1, Complex());
+        magnitudes_.assign(fftSize_ / 2 + 1, 0.0);
+        peakHold_.assign(fftSize_ / 2 + 1, 0.0);
+
+        // Periodic Hann window
+        window_.resize(fftSize_);
+        windowSum_ = 0.0;
+        for (size_t i = 0; i < fftSize_; ++i) {
+            window_[i] = 0.5 - 0.5 * std::cos(Physics::TWO_PI * i / fftSize_);
+            windowSum_ += window_[i];
+        }
+    }
+
+    clear();
+}
+
+void StreamingSpectrum::clear() {
+    std::fill(history_.begin(), history_.end(), 0.0);
+    std::fill(magnitudes_.begin(), magnitudes_.end(), 0.0);
+    std::fill(peakHold_.begin(), peakHold_.end(), 0.0);
+    writePos_ = 0;
+    samplesPushed_ = 0;
+}
+
+void StreamingSpectrum::pushSamples(const double* samples, size_t count) {
+    // Only the last fftSize_ samples can survive
+    if (count > fftSize_) {
+        samples += count - fftSize_;
+        samplesPushed_ += count - fftSize_;
+        count = fftSize_;
+    }
+
+    size_t first = std::min(count, fftSize_ - writePos_);
+    std::copy(samples, samples + first, history_.begin() + writePos_);
+    std::copy(samples + first, samples + count, history_.begin());
+
+    writePos_ = (writePos_ + count) % fftSize_;
+    samplesPushed_ += count;
+}
+
+void StreamingSpectrum::update() {
+    // Unroll the ring oldest-first while applying the window
+    size_t tail = fftSize_ - writePos_;
+    for (size_t i = 0; i < tail; ++i) {
+        frame_[i] = history_[writePos_ + i] * window_[i];
+    }
+    for (size_t i = 0; i < writePos_; ++i) {
+        frame_[tail + i] = history_[i] * window_[tail + i];
+    }
+
+    analyzer_.realFFT(plan_, frame_.data(), bins_.data());
+
+    // One-sided amplitude: DC and Nyquist are not doubled
+    double scale = windowSum_ > 0.0 ? 2.0 / windowSum_ : 0.0;
+    size_t last = bins_.size() - 1;
+    for (size_t k = 0; k <= last; ++k) {
+        double magnitude = bins_[k].magnitude() * scale;
+        if (k == 0 || k == last) magnitude *= 0.5;
+
+        magnitudes_[k] = magnitude;
+        peakHold_[k] = std::max(peakHold_[k] * peakDecay_, magnitude);
+    }
+}
+
+void StreamingSpectrum::resetPeakHold() {
+    std::copy(magnitudes_.begin(), magnitudes_.end(), peakHold_.begin());
+}
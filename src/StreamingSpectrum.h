@@ -0,0 +1,61 @@
+#ifndef STREAMING_SPECTRUM_H
+#define STREAMING_SPECTRUM_H
+
+#include "FourierAnalyzer.h"
+#include <vector>
+#include <cstddef>
+
+// Short-time spectrum over the most recent fftSize samples of a stream.
+// Samples are appended to a ring as they arrive, so each update only costs
+// the new samples plus one real FFT through a reused plan; every buffer is
+// allocated in configure().
+class StreamingSpectrum {
+public:
+    StreamingSpectrum(size_t fftSize = 4096, double sampleRate = 256.0);
+    ~StreamingSpectrum() = default;
+
+    // Rounds fftSize up to a power of two (at least 2) and clears the history
+    void configure(size_t fftSize, double sampleRate);
+    void clear();
+
+    void pushSamples(const double* samples, size_t count);
+
+    // Recomputes the Hann-windowed spectrum of the latest window and updates
+    // the peak hold. Missing history counts as silence.
+    void update();
+
+    // Peak amplitude per bin: a sine of amplitude A reads A at its bin
+    const std::vector<double>& getMagnitudes() const { return magnitudes_; }
+    const std::vector<double>& getPeakHold() const { return peakHold_; }
+    void resetPeakHold();
+
+    // Held peaks are multiplied by this factor on every update; 1 holds forever
+    void setPeakDecay(double factor) { peakDecay_ = factor; }
+    double getPeakDecay() const { return peakDecay_; }
+
+    size_t getFftSize() const { return fftSize_; }
+    size_t getBinCount() const { return magnitudes_.size(); }
+    double getSampleRate() const { return sampleRate_; }
+    double getFrequencyResolution() const { return sampleRate_ / fftSize_; }
+    size_t getSamplesPushed() const { return samplesPushed_; }
+
+private:
+    FourierAnalyzer analyzer_;
+    FFTPlan plan_;
+
+    size_t fftSize_;
+    double sampleRate_;
+    std::vector<double> history_;    // Ring of the last fftSize_ samples
+    size_t writePos_;
+    size_t samplesPushed_;
+
+    std::vector<double> window_;
+    double windowSum_;
+    std::vector<double> frame_;      // Windowed, unrolled copy of the ring
+    std::vector<Complex> bins_;
+    std::vector<double> magnitudes_;
+    std::vector<double> peakHold_;
+    double peakDecay_;
+};
+
+#endif // STREAMING_SPECTRUM_H
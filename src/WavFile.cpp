@@ -0,0 +1,447 @@
+#include "WavFile.h"
+#include "ByteOrder.h"
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <sys/types.h>
+
+namespace {
+
+constexpr uint16_t FORMAT_PCM = 1;
+constexpr uint16_t FORMAT_IEEE_FLOAT = 3;
+constexpr uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+constexpr uint64_t MAX_DATA_BYTES = 0xFFFFFFFFull - 64;   // RIFF sizes are 32-bit
+constexpr uint32_t MAX_FORMAT_BYTES = 64;                 // WAVE_FORMAT_EXTENSIBLE needs 40
+
+// Fills everything but frameCount from a "fmt " chunk body
+bool parseFormat(const unsigned char* fmt, size_t size, WavInfo& info) {
+    if (size < 16) return false;
+
+    uint16_t audioFormat = ByteOrder::getU16(fmt);
+    if (audioFormat == FORMAT_EXTENSIBLE && size >= 26) {
+        audioFormat = ByteOrder::getU16(fmt + 24);     // First two bytes of the subformat GUID
+    }
+
+    info.channels = ByteOrder::getU16(fmt + 2);
+    info.sampleRate = ByteOrder::getU32(fmt + 4);
+    uint16_t bits = ByteOrder::getU16(fmt + 14);
+
+    if (audioFormat == FORMAT_PCM && bits == 16) {
+        info.format = WavFormat::PCM16;
+    } else if (audioFormat == FORMAT_PCM && bits == 24) {
+        info.format = WavFormat::PCM24;
+    } else if (audioFormat == FORMAT_IEEE_FLOAT && bits == 32) {
+        info.format = WavFormat::FLOAT32;
+    } else {
+        return false;
+    }
+
+    return info.channels > 0 && info.sampleRate > 0;
+}
+
+// Streamed files leave the data size at 0 or 0xFFFFFFFF and mean "to the end
+// of the file"; any other size is capped by what the file actually holds
+uint64_t dataChunkBytes(uint32_t stored, uint64_t available) {
+    if (stored == 0 || stored == 0xFFFFFFFFu) return available;
+    return std::min<uint64_t>(stored, available);
+}
+
+double decodePCM16(const unsigned char* p) {
+    return static_cast<int16_t>(p[0] | (p[1] << 8)) * (1.0 / 32768.0);
+}
+
+double decodePCM24(const unsigned char* p) {
+    uint32_t bits = static_cast<uint32_t>(p[0] << 8) | (static_cast<uint32_t>(p[1]) << 16) |
+                    (static_cast<uint32_t>(p[2]) << 24);
+    return (static_cast<int32_t>(bits) >> 8) * (1.0 / 8388608.0);
+}
+
+double decodeFloat32(const unsigned char* p) {
+    uint32_t bits = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                    (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Samples per block in the contiguous decoder. g++ -O2 only vectorizes loops
+// that need no scalar epilogue, so the inner loop has a fixed trip count
+constexpr size_t DECODE_BLOCK = 8;
+
+template <size_t Bytes, double (*decode)(const unsigned char*)>
+void decodeContiguous(const unsigned char* __restrict in, size_t count, double* __restrict out) {
+    size_t i = 0;
+    for (; i + DECODE_BLOCK <= count; i += DECODE_BLOCK) {
+        for (size_t j = 0; j < DECODE_BLOCK; ++j) {
+            out[i + j] = decode(in + Bytes * (i + j));
+        }
+    }
+    for (; i < count; ++i) {
+        out[i] = decode(in + Bytes * i);
+    }
+}
+
+template <typename Decode>
+void decodeStrided(const unsigned char* in, size_t count, size_t stride, Decode decode, double* out) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = decode(in + i * stride);
+    }
+}
+
+// Stride is the distance between samples. Packed samples take the blocked
+// path, which g++ vectorizes for PCM16 and FLOAT32; 24-bit loads and
+// single-channel reads of interleaved frames stay scalar
+void decodeSamples(const unsigned char* __restrict in, size_t count, size_t stride, WavFormat format,
+                   double* __restrict out) {
+    switch (format) {
+        case WavFormat::PCM16:
+            if (stride == 2) decodeContiguous<2, decodePCM16>(in, count, out);
+            else decodeStrided(in, count, stride, decodePCM16, out);
+            break;
+        case WavFormat::PCM24:
+            if (stride == 3) decodeContiguous<3, decodePCM24>(in, count, out);
+            else decodeStrided(in, count, stride, decodePCM24, out);
+            break;
+        case WavFormat::FLOAT32:
+            if (stride == 4) decodeContiguous<4, decodeFloat32>(in, count, out);
+            else decodeStrided(in, count, stride, decodeFloat32, out);
+            break;
+    }
+}
+
+// Clamps to [-1, 1] and rounds half away from zero. The clamp keeps these
+// loops scalar: without -ffinite-math-only g++ cannot turn std::min/max on
+// doubles into vector min/max, and lrint/nearbyint are library calls at -O2
+int32_t quantize(double sample, double scale) {
+    double scaled = std::min(1.0, std::max(-1.0, sample)) * scale;
+    return static_cast<int32_t>(scaled + std::copysign(0.5, scaled));
+}
+
+void encodeSamples(const double* in, size_t count, WavFormat format, unsigned char* out) {
+    switch (format) {
+        case WavFormat::PCM16:
+            for (size_t i = 0; i < count; ++i) {
+                ByteOrder::putU16(out + 2 * i, static_cast<uint16_t>(quantize(in[i], 32767.0)));
+            }
+            break;
+        case WavFormat::PCM24:
+            for (size_t i = 0; i < count; ++i) {
+                uint32_t value = static_cast<uint32_t>(quantize(in[i], 8388607.0));
+                out[3 * i] = static_cast<unsigned char>(value);
+                out[3 * i + 1] = static_cast<unsigned char>(value >> 8);
+                out[3 * i + 2] = static_cast<unsigned char>(value >> 16);
+            }
+            break;
+        case WavFormat::FLOAT32:
+            for (size_t i = 0; i < count; ++i) {
+                float value = static_cast<float>(in[i]);
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                ByteOrder::putU32(out + 4 * i, bits);
+            }
+            break;
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// WavWriter
+
+WavWriter::~WavWriter() {
+    if (file_) close();
+}
+
+bool WavWriter::open(const std::string& path, uint32_t sampleRate, uint16_t channels, WavFormat format) {
+    if (file_ || sampleRate == 0 || channels == 0) return false;
+
+    info_ = WavInfo();
+    info_.sampleRate = sampleRate;
+    info_.channels = channels;
+    info_.format = format;
+
+    bool isFloat = format == WavFormat::FLOAT32;
+    uint16_t blockAlign = static_cast<uint16_t>(info_.bytesPerFrame());
+    uint16_t bits = static_cast<uint16_t>(8 * info_.bytesPerSample());
+
+    // Non-PCM formats carry a cbSize field and a fact chunk
+    unsigned char header[58] = {};
+    size_t size = 0;
+    std::memcpy(header, "RIFF", 4);
+    std::memcpy(header + 8, "WAVEfmt ", 8);
+    ByteOrder::putU32(header + 16, isFloat ? 18 : 16);
+    ByteOrder::putU16(header + 20, isFloat ? FORMAT_IEEE_FLOAT : FORMAT_PCM);
+    ByteOrder::putU16(header + 22, channels);
+    ByteOrder::putU32(header + 24, sampleRate);
+    ByteOrder::putU32(header + 28, sampleRate * blockAlign);
+    ByteOrder::putU16(header + 32, blockAlign);
+    ByteOrder::putU16(header + 34, bits);
+
+    if (isFloat) {
+        ByteOrder::putU16(header + 36, 0);
+        std::memcpy(header + 38, "fact", 4);
+        ByteOrder::putU32(header + 42, 4);
+        factOffset_ = 46;
+        std::memcpy(header + 50, "data", 4);
+        dataSizeOffset_ = 54;
+        size = 58;
+    } else {
+        factOffset_ = 0;
+        std::memcpy(header + 36, "data", 4);
+        dataSizeOffset_ = 40;
+        size = 44;
+    }
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return false;
+
+    if (std::fwrite(header, 1, size, file_) != size) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+
+    buffer_.resize(BLOCK_FRAMES * info_.bytesPerFrame());
+    return true;
+}
+
+bool WavWriter::writeFrames(const double* interleaved, size_t frames) {
+    if (!file_) return false;
+    if ((info_.frameCount + frames) * info_.bytesPerFrame() > MAX_DATA_BYTES) return false;
+
+    size_t channels = info_.channels;
+    for (size_t first = 0; first < frames; first += BLOCK_FRAMES) {
+        size_t count = std::min(BLOCK_FRAMES, frames - first);
+        size_t bytes = count * info_.bytesPerFrame();
+
+        encodeSamples(interleaved + first * channels, count * channels, info_.format, buffer_.data());
+        if (std::fwrite(buffer_.data(), 1, bytes, file_) != bytes) return false;
+        info_.frameCount += count;
+    }
+
+    return true;
+}
+
+bool WavWriter::close() {
+    if (!file_) return false;
+
+    uint64_t dataBytes = info_.frameCount * info_.bytesPerFrame();
+    bool ok = true;
+
+    // Chunks are word aligned
+    if (dataBytes % 2 != 0) ok = std::fputc(0, file_) != EOF;
+
+    off_t fileSize = ftello(file_);
+    unsigned char field[4];
+
+    auto patch = [&](off_t offset, uint32_t value) {
+        ByteOrder::putU32(field, value);
+        return fseeko(file_, offset, SEEK_SET) == 0 && std::fwrite(field, 1, 4, file_) == 4;
+    };
+
+    ok = ok && fileSize > 8 && patch(4, static_cast<uint32_t>(fileSize - 8));
+    ok = ok && patch(dataSizeOffset_, static_cast<uint32_t>(dataBytes));
+    if (factOffset_ != 0) ok = ok && patch(factOffset_, static_cast<uint32_t>(info_.frameCount));
+
+    ok = std::fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    return ok;
+}
+
+bool WavWriter::writeEngine(const WaveEngine& engine, const std::string& path, double duration,
+                            uint32_t sampleRate, WavFormat format) {
+    if (duration <= 0.0 || sampleRate == 0) return false;
+
+    double amplitudeSum = 0.0;
+    for (size_t i = 0; i < engine.getWaveCount(); ++i) {
+        amplitudeSum += std::abs(engine.getWave(i)->getAmplitude());
+    }
+    double gain = amplitudeSum > 0.0 ? 1.0 / amplitudeSum : 1.0;
+
+    WavWriter writer;
+    if (!writer.open(path, sampleRate, 1, format)) return false;
+
+    size_t totalFrames = static_cast<size_t>(duration * sampleRate);
+    std::vector<double> block(BLOCK_FRAMES);
+    double dt = 1.0 / sampleRate;
+
+    for (size_t first = 0; first < totalFrames; first += BLOCK_FRAMES) {
+        size_t count = std::min(BLOCK_FRAMES, totalFrames - first);
+        for (size_t i = 0; i < count; ++i) {
+            block[i] = gain * engine.evaluateSuperposition(0.0, (first + i) * dt);
+        }
+        if (!writer.writeFrames(block.data(), count)) return false;
+    }
+
+    return writer.close();
+}
+
+// ---------------------------------------------------------------------------
+// WavReader
+
+WavReader::~WavReader() {
+    close();
+}
+
+bool WavReader::open(const std::string& path) {
+    close();
+
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) return false;
+
+    unsigned char riff[12];
+    bool valid = std::fread(riff, 1, 12, file_) == 12 &&
+                 std::memcmp(riff, "RIFF", 4) == 0 && std::memcmp(riff + 8, "WAVE", 4) == 0;
+
+    // Walk the chunks until "data"; "fmt " must come first
+    bool hasFormat = false;
+    uint32_t dataSize = 0;
+    uint64_t dataBytes = 0;
+    std::vector<unsigned char> fmt;
+
+    while (valid) {
+        unsigned char chunk[8];
+        if (std::fread(chunk, 1, 8, file_) != 8) {
+            valid = false;
+            break;
+        }
+        uint32_t size = ByteOrder::getU32(chunk + 4);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            // The size comes from the file; never allocate more than a format can need
+            if (size > MAX_FORMAT_BYTES) {
+                valid = false;
+                break;
+            }
+            fmt.resize(size);
+            hasFormat = std::fread(fmt.data(), 1, size, file_) == size && parseFormat(fmt.data(), size, info_);
+            valid = hasFormat && (size % 2 == 0 || fseeko(file_, 1, SEEK_CUR) == 0);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            valid = hasFormat;
+            dataOffset_ = ftello(file_);
+            dataSize = size;
+            break;
+        } else {
+            valid = fseeko(file_, static_cast<off_t>(size) + (size % 2), SEEK_CUR) == 0;
+        }
+    }
+
+    if (valid && fseeko(file_, 0, SEEK_END) == 0) {
+        off_t end = ftello(file_);
+        dataBytes = dataChunkBytes(dataSize, end > dataOffset_ ? static_cast<uint64_t>(end - dataOffset_) : 0);
+        valid = fseeko(file_, dataOffset_, SEEK_SET) == 0;
+    }
+
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    info_.frameCount = dataBytes / info_.bytesPerFrame();
+    position_ = 0;
+    buffer_.resize(WavWriter::BLOCK_FRAMES * info_.bytesPerFrame());
+    return true;
+}
+
+void WavReader::close() {
+    if (file_) std::fclose(file_);
+    file_ = nullptr;
+    info_ = WavInfo();
+    dataOffset_ = 0;
+    position_ = 0;
+}
+
+size_t WavReader::readFrames(double* interleaved, size_t frames) {
+    if (!file_) return 0;
+    frames = static_cast<size_t>(std::min<uint64_t>(frames, info_.frameCount - position_));
+
+    size_t channels = info_.channels;
+    size_t done = 0;
+    while (done < frames) {
+        size_t count = std::min(WavWriter::BLOCK_FRAMES, frames - done);
+        size_t bytes = count * info_.bytesPerFrame();
+        size_t got = std::fread(buffer_.data(), 1, bytes, file_) / info_.bytesPerFrame();
+
+        decodeSamples(buffer_.data(), got * channels, info_.bytesPerSample(), info_.format,
+                      interleaved + done * channels);
+        done += got;
+        position_ += got;
+        if (got < count) break;
+    }
+
+    return done;
+}
+
+bool WavReader::seek(uint64_t frame) {
+    if (!file_ || frame > info_.frameCount) return false;
+
+    off_t offset = dataOffset_ + static_cast<off_t>(frame * info_.bytesPerFrame());
+    if (fseeko(file_, offset, SEEK_SET) != 0) return false;
+
+    position_ = frame;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// MappedWavFile
+
+MappedWavFile::~MappedWavFile() {
+    close();
+}
+
+bool MappedWavFile::open(const std::string& path) {
+    close();
+    if (!mapping_.open(path, 12)) return false;
+
+    const unsigned char* bytes = mapping_.data();
+    size_t size = mapping_.size();
+    bool valid = std::memcmp(bytes, "RIFF", 4) == 0 && std::memcmp(bytes + 8, "WAVE", 4) == 0;
+    bool hasFormat = false;
+
+    size_t offset = 12;
+    while (valid && offset + 8 <= size) {
+        const unsigned char* chunk = bytes + offset;
+        size_t chunkSize = ByteOrder::getU32(chunk + 4);
+        size_t body = offset + 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            hasFormat = chunkSize <= size - body && parseFormat(bytes + body, chunkSize, info_);
+            valid = hasFormat;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!hasFormat) break;
+
+            data_ = bytes + body;
+            info_.frameCount = dataChunkBytes(static_cast<uint32_t>(chunkSize), size - body) / info_.bytesPerFrame();
+            return true;
+        }
+
+        offset = body + chunkSize + (chunkSize % 2);
+    }
+
+    close();
+    return false;
+}
+
+void MappedWavFile::close() {
+    mapping_.close();
+    data_ = nullptr;
+    info_ = WavInfo();
+}
+
+size_t MappedWavFile::readFrames(uint64_t first, size_t count, double* interleaved) const {
+    if (!data_ || first >= info_.frameCount) return 0;
+    count = static_cast<size_t>(std::min<uint64_t>(count, info_.frameCount - first));
+
+    decodeSamples(data_ + first * info_.bytesPerFrame(), count * info_.channels,
+                  info_.bytesPerSample(), info_.format, interleaved);
+    return count;
+}
+
+size_t MappedWavFile::readChannel(uint16_t channel, uint64_t first, size_t count, double* output) const {
+    if (!data_ || channel >= info_.channels || first >= info_.frameCount) return 0;
+    count = static_cast<size_t>(std::min<uint64_t>(count, info_.frameCount - first));
+
+    const unsigned char* start = data_ + first * info_.bytesPerFrame() + channel * info_.bytesPerSample();
+    decodeSamples(start, count, info_.bytesPerFrame(), info_.format, output);
+    return count;
+}
@@ -0,0 +1,112 @@
+#ifndef WAV_FILE_H
+#define WAV_FILE_H
+
+#include "WaveEngine.h"
+#include "MappedFile.h"
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <sys/types.h>
+
+enum class WavFormat {
+    PCM16,
+    PCM24,
+    FLOAT32
+};
+
+struct WavInfo {
+    uint32_t sampleRate = 0;
+    uint16_t channels = 0;
+    WavFormat format = WavFormat::PCM16;
+    uint64_t frameCount = 0;        // One frame holds a sample per channel
+
+    size_t bytesPerSample() const { return format == WavFormat::PCM16 ? 2 : format == WavFormat::PCM24 ? 3 : 4; }
+    size_t bytesPerFrame() const { return bytesPerSample() * channels; }
+};
+
+// Samples are doubles in [-1, 1], interleaved by channel. PCM output is
+// clipped to that range.
+
+// Streams a RIFF/WAVE file out in blocks; the sizes are patched on close
+class WavWriter {
+public:
+    WavWriter() = default;
+    ~WavWriter();  // Closes the file if still open
+
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
+    bool open(const std::string& path, uint32_t sampleRate, uint16_t channels, WavFormat format);
+    bool writeFrames(const double* interleaved, size_t frames);
+    bool close();
+
+    uint64_t getFramesWritten() const { return info_.frameCount; }
+
+    // Superposition at x = 0, scaled by the sum of the amplitudes so it never clips
+    static bool writeEngine(const WaveEngine& engine, const std::string& path, double duration,
+                            uint32_t sampleRate, WavFormat format = WavFormat::PCM16);
+
+    static constexpr size_t BLOCK_FRAMES = 4096;
+
+private:
+    std::FILE* file_ = nullptr;
+    WavInfo info_;
+    off_t factOffset_ = 0;          // 0 when there is no fact chunk
+    off_t dataSizeOffset_ = 0;
+    std::vector<unsigned char> buffer_;
+};
+
+// Streams frames in blocks through a buffered FILE
+class WavReader {
+public:
+    WavReader() = default;
+    ~WavReader();
+
+    WavReader(const WavReader&) = delete;
+    WavReader& operator=(const WavReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file_ != nullptr; }
+    const WavInfo& getInfo() const { return info_; }
+
+    // Reads up to frames frames; returns the number read, 0 at the end
+    size_t readFrames(double* interleaved, size_t frames);
+    bool seek(uint64_t frame);
+
+private:
+    std::FILE* file_ = nullptr;
+    WavInfo info_;
+    off_t dataOffset_ = 0;
+    uint64_t position_ = 0;
+    std::vector<unsigned char> buffer_;
+};
+
+// Maps the file read-only; any range converts straight from the mapping
+class MappedWavFile {
+public:
+    MappedWavFile() = default;
+    ~MappedWavFile();
+
+    MappedWavFile(const MappedWavFile&) = delete;
+    MappedWavFile& operator=(const MappedWavFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping_.isOpen(); }
+    const WavInfo& getInfo() const { return info_; }
+
+    // Frames [first, first + count) interleaved, or one channel of them;
+    // both return the number of frames converted
+    size_t readFrames(uint64_t first, size_t count, double* interleaved) const;
+    size_t readChannel(uint16_t channel, uint64_t first, size_t count, double* output) const;
+
+private:
+    MappedFile mapping_;
+    const unsigned char* data_ = nullptr;
+    WavInfo info_;
+};
+
+#endif // WAV_FILE_H
@@ -4,20 +4,28 @@
 #include <numeric>
 #include <sstream>
 
-WaveEngine::WaveEngine(double velocity) : velocity_(velocity), currentTime_(0.0) {}
+WaveEngine::WaveEngine(double velocity)
+    : velocity_(velocity), currentTime_(0.0), waveVersion_(0), analysisVersion_(0), analysisTolerance_(0.0) {}
 
 void WaveEngine::addWave(std::unique_ptr<WaveFunction> wave) {
     waves_.push_back(std::move(wave));
+    ++waveVersion_;
 }
 
 void WaveEngine::removeWave(size_t index) {
     if (index < waves_.size()) {
         waves_.erase(waves_.begin() + index);
+        ++waveVersion_;
     }
 }
 
 void WaveEngine::clearWaves() {
     waves_.clear();
+    ++waveVersion_;
+}
+
+void WaveEngine::reserveWaves(size_t count) {
+    waves_.reserve(count);
 }
 
 const WaveFunction* WaveEngine::getWave(size_t index) const {
@@ -27,6 +35,18 @@ const WaveFunction* WaveEngine::getWave(size_t index) const {
     return nullptr;
 }
 
+std::unique_ptr<WaveEngine> WaveEngine::clone() const {
+    auto copy = std::make_unique<WaveEngine>(velocity_);
+    copy->currentTime_ = currentTime_;
+    
+    copy->reserveWaves(waves_.size());
+    for (const auto& wave : waves_) {
+        copy->addWave(WaveFunction::create(wave->getType(), wave->getAmplitude(), wave->getFrequency(), wave->getPhase()));
+    }
+    
+    return copy;
+}
+
 double WaveEngine::evaluateSuperposition(double x, double t) const {
     double result = 0.0;
     for (const auto& wave : waves_) {
@@ -59,34 +79,37 @@ std::vector<double> WaveEngine::generateTimeSeries(double duration, double sampl
 
 std::vector<TimePoint> WaveEngine::generateDetailedTimeSeries(double duration, double sampleRate, double position) const {
     std::vector<TimePoint> data;
+    if (sampleRate <= 0.0 || duration <= 0.0) return data;
+    
+    data.resize(static_cast<size_t>(duration * sampleRate));
+    generateDetailedTimeSeries(0, data.size(), sampleRate, position, data.data());
+    
+    return data;
+}
+
+void WaveEngine::generateDetailedTimeSeries(size_t firstSample, size_t numSamples, double sampleRate,
+                                            double position, TimePoint* output) const {
+    if (sampleRate <= 0.0) return;
+    
     double dt = 1.0 / sampleRate;
-    int numSamples = static_cast<int>(duration * sampleRate);
     
-    data.reserve(numSamples);
+    // Carry the two preceding amplitudes so chunk boundaries are seamless
+    double prevAmp = firstSample >= 1 ? evaluateSuperposition(position, (firstSample - 1) * dt) : 0.0;
+    double prevPrevAmp = firstSample >= 2 ? evaluateSuperposition(position, (firstSample - 2) * dt) : 0.0;
     
-    for (int i = 0; i < numSamples; ++i) {
-        double t = i * dt;
+    for (size_t i = 0; i < numSamples; ++i) {
+        size_t index = firstSample + i;
+        double t = index * dt;
         double amp = evaluateSuperposition(position, t);
         
-        // Calculate velocity (numerical derivative)
-        double vel = 0.0;
-        if (i > 0) {
-            double prev_amp = evaluateSuperposition(position, (i-1) * dt);
-            vel = (amp - prev_amp) / dt;
-        }
-        
-        // Calculate acceleration (second derivative)
-        double acc = 0.0;
-        if (i > 1) {
-            double prev_amp = evaluateSuperposition(position, (i-1) * dt);
-            double prev_prev_amp = evaluateSuperposition(position, (i-2) * dt);
-            acc = (amp - 2 * prev_amp + prev_prev_amp) / (dt * dt);
-        }
+        // Backward differences; zero where the earlier samples do not exist
+        double vel = index > 0 ? (amp - prevAmp) / dt : 0.0;
+        double acc = index > 1 ? (amp - 2 * prevAmp + prevPrevAmp) / (dt * dt) : 0.0;
         
-        data.push_back({t, amp, vel, acc});
+        output[i] = {t, amp, vel, acc};
+        prevPrevAmp = prevAmp;
+        prevAmp = amp;
     }
-    
-    return data;
 }
 
 std::vector<double> WaveEngine::generateSpatialSeries(double length, double sampleRate, double time) const {
@@ -138,23 +161,31 @@ WaveAnalysis WaveEngine::analyzeWaves(const std::vector<double>& data, double sa
 double WaveEngine::calculateBeatFrequency() const {
     if (waves_.size() < 2) return 0.0;
     
+    // Beat frequency is the difference between closest frequencies
+    return analyzeFrequencies()->closestSpacing;
+}
+
+std::shared_ptr<const FrequencyAnalysis> WaveEngine::analyzeFrequencies(double tolerance) const {
+    std::lock_guard<std::mutex> lock(analysisMutex_);
+    
+    if (!analysis_ || analysisVersion_ != waveVersion_ || analysisTolerance_ != tolerance) {
+        // A new result replaces the old one; callers still holding the old one keep it
+        analysis_ = std::make_shared<const FrequencyAnalysis>(
+            FrequencyClusterer().analyze(collectFrequencies(), tolerance));
+        analysisVersion_ = waveVersion_;
+        analysisTolerance_ = tolerance;
+    }
+    
+    return analysis_;
+}
+
+std::vector<double> WaveEngine::collectFrequencies() const {
     std::vector<double> frequencies;
+    frequencies.reserve(waves_.size());
     for (const auto& wave : waves_) {
         frequencies.push_back(wave->getFrequency());
     }
-    
-    std::sort(frequencies.begin(), frequencies.end());
-    
-    // Beat frequency is the difference between closest frequencies
-    double minDiff = std::numeric_limits<double>::max();
-    for (size_t i = 1; i < frequencies.size(); ++i) {
-        double diff = frequencies[i] - frequencies[i-1];
-        if (diff > 0 && diff < minDiff) {
-            minDiff = diff;
-        }
-    }
-    
-    return minDiff < std::numeric_limits<double>::max() ? minDiff : 0.0;
+    return frequencies;
 }
 
 bool WaveEngine::detectInterference() const {
@@ -165,29 +196,15 @@ std::string WaveEngine::detectPhenomenon() const {
     if (waves_.size() == 0) return "No waves";
     if (waves_.size() == 1) return "Single wave";
     
-    double beatFreq = calculateBeatFrequency();
+    auto analysis = analyzeFrequencies();
+    
+    double beatFreq = analysis->closestSpacing;
     if (beatFreq > 0 && beatFreq < 2.0) {
         return "Beating";
     }
     
     // Check for resonance (waves with same frequency)
-    std::vector<double> frequencies;
-    for (const auto& wave : waves_) {
-        frequencies.push_back(wave->getFrequency());
-    }
-    
-    bool hasResonance = false;
-    for (size_t i = 0; i < frequencies.size(); ++i) {
-        for (size_t j = i + 1; j < frequencies.size(); ++j) {
-            if (std::abs(frequencies[i] - frequencies[j]) < 0.01) {
-                hasResonance = true;
-                break;
-            }
-        }
-        if (hasResonance) break;
-    }
-    
-    if (hasResonance) return "Resonance";
+    if (analysis->hasResonance()) return "Resonance";
     
     return "Superposition";
 }
@@ -2,8 +2,11 @@
 #define WAVE_ENGINE_H
 
 #include "WaveFunction.h"
+#include "FrequencyClusterer.h"
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <cstdint>
 
 struct WaveAnalysis {
     double maxAmplitude;
@@ -28,6 +31,16 @@ private:
     double velocity_;
     double currentTime_;
     
+    // Bumped whenever the wave set changes; the frequency analysis is cached
+    // per (version, tolerance) and shared read-only with callers
+    uint64_t waveVersion_;
+    mutable std::mutex analysisMutex_;
+    mutable std::shared_ptr<const FrequencyAnalysis> analysis_;
+    mutable uint64_t analysisVersion_;
+    mutable double analysisTolerance_;
+    
+    std::vector<double> collectFrequencies() const;
+    
 public:
     WaveEngine(double velocity = 1.0);
     ~WaveEngine() = default;
@@ -36,9 +49,13 @@ public:
     void addWave(std::unique_ptr<WaveFunction> wave);
     void removeWave(size_t index);
     void clearWaves();
+    void reserveWaves(size_t count);  // Preallocates before adding many waves
     size_t getWaveCount() const { return waves_.size(); }
     const WaveFunction* getWave(size_t index) const;
     
+    // Independent copy of the waves and properties, e.g. for a worker thread
+    std::unique_ptr<WaveEngine> clone() const;
+    
     // Wave evaluation
     double evaluateSuperposition(double x, double t) const;
     double evaluateWave(size_t waveIndex, double x, double t) const;
@@ -47,12 +64,19 @@ public:
     std::vector<double> generateTimeSeries(double duration, double sampleRate, double position = 0.0) const;
     std::vector<TimePoint> generateDetailedTimeSeries(double duration, double sampleRate, double position = 0.0) const;
     
+    // Samples [firstSample, firstSample + numSamples) of the series above, so
+    // long series can be produced in chunks; one evaluation per sample
+    void generateDetailedTimeSeries(size_t firstSample, size_t numSamples, double sampleRate,
+                                    double position, TimePoint* output) const;
+    
     // Spatial series generation
     std::vector<double> generateSpatialSeries(double length, double sampleRate, double time = 0.0) const;
     
     // Analysis
     WaveAnalysis analyzeWaves(const std::vector<double>& data, double sampleRate) const;
     double calculateBeatFrequency() const;
+    // Reused until the waves or the tolerance change; safe for concurrent readers
+    std::shared_ptr<const FrequencyAnalysis> analyzeFrequencies(double tolerance = 0.01) const;
     bool detectInterference() const;
     std::string detectPhenomenon() const;
     
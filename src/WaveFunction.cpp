@@ -112,4 +112,20 @@ void SawtoothWave::setParameters(double amplitude, double frequency, double phas
     amplitude_ = amplitude;
     frequency_ = frequency;
     phase_ = phase;
-}
\ No newline at end of file
+}
+
+// WaveFunction factory
+std::unique_ptr<WaveFunction> WaveFunction::create(WaveType type, double amplitude, double frequency, double phase) {
+    switch (type) {
+        case WaveType::COSINE:
+            return std::make_unique<CosineWave>(amplitude, frequency, phase);
+        case WaveType::SQUARE:
+            return std::make_unique<SquareWave>(amplitude, frequency, phase);
+        case WaveType::TRIANGULAR:
+            return std::make_unique<TriangularWave>(amplitude, frequency, phase);
+        case WaveType::SAWTOOTH:
+            return std::make_unique<SawtoothWave>(amplitude, frequency, phase);
+        default:
+            return std::make_unique<SinusoidalWave>(amplitude, frequency, phase);
+    }
+}
@@ -33,6 +33,9 @@ public:
     virtual double getAngularFrequency() const { return Physics::TWO_PI * getFrequency(); }
     virtual double getWaveNumber(double velocity = 1.0) const { return Physics::TWO_PI / getWavelength(velocity); }
     virtual double getEnergy() const { return 0.5 * getAmplitude() * getAmplitude(); }
+    
+    // Concrete wave of the given type; CUSTOM falls back to a sine
+    static std::unique_ptr<WaveFunction> create(WaveType type, double amplitude, double frequency, double phase);
 };
 
 class SinusoidalWave : public WaveFunction {
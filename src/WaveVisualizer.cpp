@@ -2,8 +2,12 @@
 #include <QtGui/QPainter>
 #include <QtGui/QPen>
 #include <QtGui/QBrush>
+#include <QtGui/QTransform>
 #include <QtCore/QDebug>
 #include <cmath>
+#include <algorithm>
+#include <limits>
+#include <chrono>
 
 WaveVisualizer::WaveVisualizer(QWidget *parent)
     : QWidget(parent)
@@ -11,18 +15,68 @@ WaveVisualizer::WaveVisualizer(QWidget *parent)
     , m_plotFrame(nullptr)
     , m_infoLayout(nullptr)
     , m_infoLabel(nullptr)
+    , m_logScaleCheck(nullptr)
+    , m_peakHoldCheck(nullptr)
     , m_waveEngine(nullptr)
     , m_mode(VisualizationMode::TIME_DOMAIN)
+    , m_plotVersion(0)
+    , m_dataMinY(0.0)
+    , m_dataMaxY(0.0)
+    , m_hasDataRange(false)
+    , m_hasPendingRequest(false)
+    , m_frameReady(false)
+    , m_stopWorker(false)
+    , m_hasLastRequest(false)
+    , m_awaitingFrame(false)
+    , m_requestSerial(0)
+    , m_dataRate(0.0)
+    , m_spectrum(SPECTRUM_SIZE, SPECTRUM_MIN_RATE)
+    , m_spectrumStart(0.0)
+    , m_spectrumSamples(0)
+    , m_spectrumViewMinX(std::numeric_limits<double>::quiet_NaN())
+    , m_spectrumViewMaxX(std::numeric_limits<double>::quiet_NaN())
+    , m_spectrumViewColumns(0)
+    , m_spectrumScale(SpectrumScale::LINEAR)
+    , m_showPeakHold(true)
+    , m_waterfallHead(0)
+    , m_waterfallMinX(0.0)
+    , m_waterfallMaxX(0.0)
+    , m_scrolling(false)
+    , m_scrollColumns(0)
+    , m_scrollColumn(0)
+    , m_scrollWindow(0.0)
+    , m_scrollColumnTime(0.0)
+    , m_scrollSamples(2)
+    , m_scrollBound(0.0)
+    , m_sourceSpacing(1.0)
+    , m_hasHeatmapRequest(false)
+    , m_heatmapBlock(0)
+    , m_layerMinX(0.0)
+    , m_layerMaxX(0.0)
+    , m_layerMinY(0.0)
+    , m_layerMaxY(0.0)
+    , m_layerGrid(false)
+    , m_layerAxes(false)
+    , m_pathMinX(0.0)
+    , m_pathMaxX(0.0)
+    , m_pathMinY(0.0)
+    , m_pathMaxY(0.0)
+    , m_pathVersion(0)
     , m_minX(-5.0)
     , m_maxX(5.0)
     , m_minY(-5.0)
     , m_maxY(5.0)
     , m_currentTime(0.0)
+    , m_dirty(true)
+    , m_refreshPending(false)
+    , m_droppedFrames(0)
+    , m_showFrameStats(false)
     , m_showGrid(true)
     , m_showLegend(true)
     , m_showAxes(true)
     , m_autoScale(true)
     , m_showCursor(false)
+    , m_cachePaths(false)
     , m_isPanning(false)
     , m_plotMargins(60, 40, 40, 60)
     , m_backgroundColor(Qt::white)
@@ -37,10 +91,21 @@ WaveVisualizer::WaveVisualizer(QWidget *parent)
     
     setMinimumSize(400, 300);
     
+    buildColormap();
     setupUI();
+    
+    m_rasterizer.setColormap(std::vector<uint32_t>(m_colormap.begin(), m_colormap.end()));
+    m_rasterizer.setReadyCallback([this]() {
+        QMetaObject::invokeMethod(this, [this]() { takeHeatmap(); }, Qt::QueuedConnection);
+    });
+    
+    m_worker = std::thread(&WaveVisualizer::workerLoop, this);
 }
 
-WaveVisualizer::~WaveVisualizer() = default;
+WaveVisualizer::~WaveVisualizer() {
+    m_rasterizer.setReadyCallback(nullptr);
+    stopWorker();
+}
 
 void WaveVisualizer::setupUI() {
     m_layout = new QVBoxLayout(this);
@@ -56,18 +121,38 @@ void WaveVisualizer::setupUI() {
     m_infoLayout = new QHBoxLayout();
     m_infoLabel = new QLabel("Ready");
     m_infoLabel->setStyleSheet("QLabel { padding: 5px; background-color: #f0f0f0; }");
-    m_infoLayout->addWidget(m_infoLabel);
+    m_infoLayout->addWidget(m_infoLabel, 1);
+    
+    // Spectrum display options, shown only in frequency mode
+    m_logScaleCheck = new QCheckBox("Log (dB)");
+    m_peakHoldCheck = new QCheckBox("Peak hold");
+    m_peakHoldCheck->setChecked(m_showPeakHold);
+    m_logScaleCheck->setVisible(false);
+    m_peakHoldCheck->setVisible(false);
+    m_infoLayout->addWidget(m_logScaleCheck);
+    m_infoLayout->addWidget(m_peakHoldCheck);
+    
+    connect(m_logScaleCheck, &QCheckBox::toggled, [this](bool checked) {
+        setSpectrumScale(checked ? SpectrumScale::LOGARITHMIC : SpectrumScale::LINEAR);
+    });
+    connect(m_peakHoldCheck, &QCheckBox::toggled, [this](bool checked) {
+        setShowPeakHold(checked);
+    });
     m_layout->addLayout(m_infoLayout);
 }
 
 void WaveVisualizer::setWaveEngine(WaveEngine* engine) {
     m_waveEngine = engine;
-    updateVisualization();
+    invalidate();
 }
 
 void WaveVisualizer::setVisualizationMode(VisualizationMode mode) {
     m_mode = mode;
-    updateVisualization();
+    
+    bool spectrum = (mode == VisualizationMode::FREQUENCY_DOMAIN);
+    m_logScaleCheck->setVisible(spectrum);
+    m_peakHoldCheck->setVisible(spectrum);
+    invalidate();
 }
 
 void WaveVisualizer::setTimeRange(double startTime, double endTime) {
@@ -88,17 +173,74 @@ void WaveVisualizer::setFrequencyRange(double startFreq, double endFreq) {
     }
 }
 
+void WaveVisualizer::setSpectrumScale(SpectrumScale scale) {
+    if (scale == m_spectrumScale) return;
+    
+    m_spectrumScale = scale;
+    if (m_mode == VisualizationMode::FREQUENCY_DOMAIN) invalidate();
+}
+
+void WaveVisualizer::setShowPeakHold(bool show) {
+    m_showPeakHold = show;
+    update();
+}
+
+void WaveVisualizer::resetPeakHold() {
+    m_spectrum.resetPeakHold();
+    if (m_mode == VisualizationMode::FREQUENCY_DOMAIN) invalidate();
+}
+
+void WaveVisualizer::setScrolling(bool enable) {
+    if (enable == m_scrolling) return;
+    
+    m_scrolling = enable;
+    m_scrollRing.clear();
+    m_hasLastRequest = false;
+    if (m_mode == VisualizationMode::TIME_DOMAIN) invalidate();
+}
+
+void WaveVisualizer::setSourceSpacing(double spacing) {
+    m_sourceSpacing = spacing;
+    m_fieldWaves.clear();    // Rebuild the sources on the next request
+    if (m_mode == VisualizationMode::INTERFERENCE_PATTERN) invalidate();
+}
+
 void WaveVisualizer::setCurrentTime(double time) {
     m_currentTime = time;
-    updateVisualization();
+    invalidate();
+}
+
+void WaveVisualizer::invalidate() {
+    m_dirty = true;
+    if (!isVisible() || m_refreshPending) return;
+    
+    // Coalesce every change made during this event-loop pass into one refresh
+    m_refreshPending = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        m_refreshPending = false;
+        refresh();
+    }, Qt::QueuedConnection);
+}
+
+void WaveVisualizer::refresh() {
+    if (m_dirty && isVisible()) updateVisualization();
 }
 
 void WaveVisualizer::updateVisualization() {
     if (!m_waveEngine) return;
     
+    m_dirty = false;
+    
+    QElapsedTimer generationTimer;
+    generationTimer.start();
+    
     switch (m_mode) {
         case VisualizationMode::TIME_DOMAIN:
-            generateTimeData();
+            if (m_scrolling) {
+                advanceScrollingWindow();
+            } else {
+                generateTimeData();
+            }
             break;
         case VisualizationMode::FREQUENCY_DOMAIN:
             generateFrequencyData();
@@ -107,8 +249,17 @@ void WaveVisualizer::updateVisualization() {
             generateSuperpositionData();
             break;
         case VisualizationMode::INTERFERENCE_PATTERN:
-            generateTimeData(); // For now, same as time domain
+            requestHeatmap();
             break;
+        case VisualizationMode::SPECTROGRAM:
+            generateSpectrogramData();
+            break;
+    }
+    
+    // Time-domain modes generate on the worker and report from swapPlotData
+    if (m_mode == VisualizationMode::FREQUENCY_DOMAIN || m_mode == VisualizationMode::SPECTROGRAM ||
+        scrollingView()) {
+        m_generateStats.record(generationTimer.nsecsElapsed() / 1e6);
     }
     
     updateTransform();
@@ -116,7 +267,7 @@ void WaveVisualizer::updateVisualization() {
 }
 
 void WaveVisualizer::onWaveDataChanged() {
-    updateVisualization();
+    invalidate();
 }
 
 void WaveVisualizer::onTimeChanged(double time) {
@@ -124,24 +275,45 @@ void WaveVisualizer::onTimeChanged(double time) {
 }
 
 void WaveVisualizer::paintEvent(QPaintEvent *event) {
-    Q_UNUSED(event)
+    // Cursor moves repaint only a strip; keep them out of the frame timings
+    bool fullFrame = (event->rect() == rect());
     
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    QElapsedTimer paintTimer;
+    paintTimer.start();
     
-    // Fill background
-    painter.fillRect(rect(), m_backgroundColor);
+    if (fullFrame) {
+        if (m_frameClock.isValid()) {
+            m_frameStats.record(m_frameClock.nsecsElapsed() / 1e6);
+        }
+        m_frameClock.start();
+    }
+    
+    QPainter painter(this);
     
     // Update plot rectangle
     m_plotRect = rect().marginsRemoved(m_plotMargins);
     
-    // Draw components
-    if (m_showGrid) drawGrid(painter);
-    if (m_showAxes) drawAxes(painter);
+    // Ask for data matching the current view; a no-op if it has not moved
+    if (m_mode == VisualizationMode::FREQUENCY_DOMAIN) {
+        decimateSpectrum();
+    } else if (m_mode == VisualizationMode::INTERFERENCE_PATTERN) {
+        requestHeatmap();
+    } else if (m_waveEngine && m_mode != VisualizationMode::SPECTROGRAM && !scrollingView()) {
+        requestPlotData(m_mode == VisualizationMode::SUPERPOSITION);
+    }
+    
+    // Background, grid and axes come from the cached layer
+    updateStaticLayers();
+    painter.drawPixmap(0, 0, m_staticLayer);
+    painter.setRenderHint(QPainter::Antialiasing);
     
     switch (m_mode) {
         case VisualizationMode::TIME_DOMAIN:
-            drawWaveform(painter);
+            if (m_scrolling) {
+                drawScrollingWaveform(painter);
+            } else {
+                drawWaveform(painter);
+            }
             break;
         case VisualizationMode::FREQUENCY_DOMAIN:
             drawSpectrum(painter);
@@ -150,13 +322,81 @@ void WaveVisualizer::paintEvent(QPaintEvent *event) {
             drawSuperposition(painter);
             break;
         case VisualizationMode::INTERFERENCE_PATTERN:
-            drawWaveform(painter);
+            drawInterferencePattern(painter);
+            break;
+        case VisualizationMode::SPECTROGRAM:
+            drawSpectrogram(painter);
             break;
     }
     
     if (m_showCursor) drawCursor(painter);
-    if (m_showLegend) drawLegend(painter);
-    drawMeasurements(painter);
+    if (m_showLegend && !m_legendLayer.isNull()) painter.drawPixmap(m_legendRect.topLeft(), m_legendLayer);
+    if (m_showFrameStats) drawFrameStats(painter);
+    if (fullFrame) {
+        drawMeasurements(painter);
+        m_paintStats.record(paintTimer.nsecsElapsed() / 1e6);
+    }
+}
+
+void WaveVisualizer::updateStaticLayers() {
+    qreal ratio = devicePixelRatioF();
+    QSize pixelSize(static_cast<int>(width() * ratio), static_cast<int>(height() * ratio));
+    
+    bool layerValid = !m_staticLayer.isNull() && m_layerSize == pixelSize &&
+                      m_layerMinX == m_minX && m_layerMaxX == m_maxX &&
+                      m_layerMinY == m_minY && m_layerMaxY == m_maxY &&
+                      m_layerGrid == m_showGrid && m_layerAxes == m_showAxes;
+    
+    if (!layerValid) {
+        if (m_staticLayer.isNull() || m_layerSize != pixelSize) {
+            m_staticLayer = QPixmap(pixelSize);
+            m_staticLayer.setDevicePixelRatio(ratio);
+        }
+        m_staticLayer.fill(m_backgroundColor);
+        
+        QPainter layer(&m_staticLayer);
+        layer.setRenderHint(QPainter::Antialiasing);
+        if (m_showGrid) drawGrid(layer);
+        if (m_showAxes) drawAxes(layer);
+        
+        m_layerSize = pixelSize;
+        m_layerMinX = m_minX;
+        m_layerMaxX = m_maxX;
+        m_layerMinY = m_minY;
+        m_layerMaxY = m_maxY;
+        m_layerGrid = m_showGrid;
+        m_layerAxes = m_showAxes;
+    }
+    
+    // The legend depends only on the waves and where the plot sits
+    if (!m_showLegend || !m_waveEngine) {
+        m_legendLayer = QPixmap();
+        return;
+    }
+    
+    std::vector<double> waves = snapshotWaves();
+    QRect target = legendRect();
+    if (!m_legendLayer.isNull() && waves == m_legendWaves && target == m_legendRect) return;
+    
+    m_legendLayer = QPixmap(static_cast<int>((target.width() + 1) * ratio),
+                            static_cast<int>((target.height() + 1) * ratio));
+    m_legendLayer.setDevicePixelRatio(ratio);
+    m_legendLayer.fill(Qt::transparent);
+    
+    QPainter legend(&m_legendLayer);
+    legend.setRenderHint(QPainter::Antialiasing);
+    legend.translate(-target.left(), -target.top());
+    drawLegend(legend);
+    
+    m_legendWaves = std::move(waves);
+    m_legendRect = target;
+}
+
+void WaveVisualizer::showEvent(QShowEvent *event) {
+    Q_UNUSED(event)
+    
+    // Hidden tabs skip regeneration; catch up before the first paint
+    refresh();
 }
 
 void WaveVisualizer::mousePressEvent(QMouseEvent *event) {
@@ -186,11 +426,25 @@ void WaveVisualizer::mouseMoveEvent(QMouseEvent *event) {
         updateTransform();
         update();
     } else {
+        QPointF previous = worldToScreen(m_cursorPos.x(), m_cursorPos.y());
         m_cursorPos = screenToWorld(event->pos());
-        if (m_showCursor) update();
+        
+        // Only the old and new cross-hair strips need repainting
+        if (m_showCursor) {
+            updateCursorRegion(previous);
+            updateCursorRegion(worldToScreen(m_cursorPos.x(), m_cursorPos.y()));
+        }
     }
 }
 
+void WaveVisualizer::updateCursorRegion(const QPointF &screenPos) {
+    int x = static_cast<int>(screenPos.x());
+    int y = static_cast<int>(screenPos.y());
+    
+    update(QRect(m_plotRect.left(), y - 2, m_plotRect.width() + 1, 5));
+    update(QRect(x - 2, m_plotRect.top(), 5, m_plotRect.height() + 1));
+}
+
 void WaveVisualizer::wheelEvent(QWheelEvent *event) {
     if (m_plotRect.contains(event->pos())) {
         double factor = (event->delta() > 0) ? (1.0 / ZOOM_FACTOR) : ZOOM_FACTOR;
@@ -264,33 +518,53 @@ void WaveVisualizer::drawWaveform(QPainter &painter) {
     if (m_plotData.empty()) return;
     
     painter.setPen(m_wavePen);
-    
-    for (size_t i = 1; i < m_plotData.size(); ++i) {
-        QPointF pt1 = worldToScreen(m_plotData[i-1].x(), m_plotData[i-1].y());
-        QPointF pt2 = worldToScreen(m_plotData[i].x(), m_plotData[i].y());
-        
-        if (m_plotRect.contains(pt1.toPoint()) || m_plotRect.contains(pt2.toPoint())) {
-            painter.drawLine(pt1, pt2);
-        }
-    }
+    drawSeries(painter, m_plotData, 0);
 }
 
 void WaveVisualizer::drawSpectrum(QPainter &painter) {
     if (m_spectrumData.empty()) return;
     
+    if (m_showPeakHold) {
+        painter.setPen(QPen(m_waveColor.lighter(160), 1));
+        drawSeries(painter, m_peakHoldData, 1);
+    }
+    
     painter.setPen(m_wavePen);
-    painter.setBrush(QBrush(m_waveColor.lighter(150)));
+    drawSeries(painter, m_spectrumData, 0);
+}
+
+void WaveVisualizer::drawSpectrogram(QPainter &painter) {
+    if (m_waterfall.isNull() || m_plotRect.isEmpty()) return;
     
-    for (const auto& point : m_spectrumData) {
-        QPointF screenPt = worldToScreen(point.x(), point.y());
-        QPointF basePt = worldToScreen(point.x(), 0);
-        
-        if (m_plotRect.contains(screenPt.toPoint())) {
-            painter.drawLine(basePt, screenPt);
-        }
+    // Rows from the head to the end of the image are the newest; two blits
+    // show the whole history without moving any pixels
+    int newerRows = WATERFALL_ROWS - m_waterfallHead;
+    double rowHeight = static_cast<double>(m_plotRect.height()) / WATERFALL_ROWS;
+    double top = m_plotRect.top();
+    
+    painter.drawImage(QRectF(m_plotRect.left(), top, m_plotRect.width(), newerRows * rowHeight),
+                      m_waterfall, QRectF(0, m_waterfallHead, WATERFALL_BINS, newerRows));
+    
+    if (m_waterfallHead > 0) {
+        painter.drawImage(QRectF(m_plotRect.left(), top + newerRows * rowHeight,
+                                 m_plotRect.width(), m_waterfallHead * rowHeight),
+                          m_waterfall, QRectF(0, 0, WATERFALL_BINS, m_waterfallHead));
     }
 }
 
+void WaveVisualizer::drawInterferencePattern(QPainter &painter) {
+    if (m_heatmapPixels.empty() || m_heatmapView.width <= 0) return;
+    
+    // Coarse passes are scaled up as they are; the next pass replaces them
+    QPointF topLeft = worldToScreen(m_heatmapView.minX, m_heatmapView.maxY);
+    QPointF bottomRight = worldToScreen(m_heatmapView.maxX, m_heatmapView.minY);
+    
+    painter.save();
+    painter.setClipRect(m_plotRect);
+    painter.drawImage(QRectF(topLeft, bottomRight), m_heatmapImage);
+    painter.restore();
+}
+
 void WaveVisualizer::drawSuperposition(QPainter &painter) {
     // Draw individual waves with different colors
     QColor colors[] = {Qt::blue, Qt::red, Qt::green, Qt::magenta, Qt::cyan};
@@ -298,27 +572,81 @@ void WaveVisualizer::drawSuperposition(QPainter &painter) {
     for (size_t waveIdx = 0; waveIdx < m_multiWaveData.size(); ++waveIdx) {
         QPen pen(colors[waveIdx % 5], 1, Qt::DashLine);
         painter.setPen(pen);
-        
-        const auto& waveData = m_multiWaveData[waveIdx];
-        for (size_t i = 1; i < waveData.size(); ++i) {
-            QPointF pt1 = worldToScreen(waveData[i-1].x(), waveData[i-1].y());
-            QPointF pt2 = worldToScreen(waveData[i].x(), waveData[i].y());
-            
-            if (m_plotRect.contains(pt1.toPoint()) || m_plotRect.contains(pt2.toPoint())) {
-                painter.drawLine(pt1, pt2);
-            }
-        }
+        drawSeries(painter, m_multiWaveData[waveIdx], waveIdx + 1);
     }
     
     // Draw superposition with thick line
     painter.setPen(QPen(Qt::black, 3));
-    drawWaveform(painter);
+    drawSeries(painter, m_plotData, 0);
+}
+
+void WaveVisualizer::drawSeries(QPainter &painter, const std::vector<QPointF>& data, size_t seriesIndex) {
+    if (data.size() < 2) return;
+    
+    // One call per series; the clip replaces the old per-segment containment test
+    painter.save();
+    painter.setClipRect(m_plotRect);
+    painter.setBrush(Qt::NoBrush);
+    
+    if (m_cachePaths) {
+        painter.drawPath(cachedPath(data, seriesIndex));
+    } else {
+        toScreenPolyline(data, m_polyline);
+        painter.drawPolyline(m_polyline);
+    }
+    
+    painter.restore();
+}
+
+void WaveVisualizer::drawScrollingWaveform(QPainter &painter) {
+    if (m_scrollRing.isEmpty() || m_plotRect.isEmpty()) return;
+    
+    // Ring x values are slot numbers and y values are world units; a transform
+    // per run places them, so scrolling never rewrites the stored points
+    int columns = m_scrollColumns;
+    int oldest = static_cast<int>(((m_scrollColumn + 1) % columns + columns) % columns);
+    double scaleX = static_cast<double>(m_plotRect.width()) / columns;
+    double scaleY = m_plotRect.height() / (m_maxY - m_minY);
+    double originY = m_plotRect.bottom() + m_minY * scaleY;
+    
+    auto runTransform = [&](int firstSlot, int screenColumn) {
+        QTransform transform;
+        transform.translate(m_plotRect.left() + (screenColumn - firstSlot) * scaleX, originY);
+        transform.scale(scaleX, -scaleY);
+        return transform;
+    };
+    
+    QPen pen = m_wavePen;
+    pen.setCosmetic(true);
+    
+    painter.save();
+    painter.setClipRect(m_plotRect);
+    painter.setBrush(Qt::NoBrush);
+    painter.setPen(pen);
+    
+    // Oldest columns run from the wrap offset to the end of the ring
+    QTransform older = runTransform(oldest, 0);
+    painter.setTransform(older);
+    painter.drawPolyline(m_scrollRing.constData() + 2 * oldest, 2 * (columns - oldest));
+    painter.resetTransform();
+    
+    if (oldest > 0) {
+        QTransform newer = runTransform(0, columns - oldest);
+        painter.setTransform(newer);
+        painter.drawPolyline(m_scrollRing.constData(), 2 * oldest);
+        painter.resetTransform();
+        
+        // Join the two runs across the wrap
+        painter.drawLine(older.map(m_scrollRing[2 * columns - 1]), newer.map(m_scrollRing[0]));
+    }
+    
+    painter.restore();
 }
 
 void WaveVisualizer::drawLegend(QPainter &painter) {
     if (!m_waveEngine) return;
     
-    QRect legendRect(m_plotRect.right() - 200, m_plotRect.top() + 10, 190, 20 * m_waveEngine->getWaveCount() + 20);
+    QRect legendRect = this->legendRect();
     
     painter.setPen(Qt::black);
     painter.setBrush(QBrush(Qt::white, Qt::SolidPattern));
@@ -342,6 +670,11 @@ void WaveVisualizer::drawLegend(QPainter &painter) {
     }
 }
 
+QRect WaveVisualizer::legendRect() const {
+    size_t waveCount = m_waveEngine ? m_waveEngine->getWaveCount() : 0;
+    return QRect(m_plotRect.right() - 200, m_plotRect.top() + 10, 190, 20 * static_cast<int>(waveCount) + 20);
+}
+
 void WaveVisualizer::drawCursor(QPainter &painter) {
     if (!m_showCursor) return;
     
@@ -373,6 +706,16 @@ void WaveVisualizer::drawMeasurements(QPainter &painter) {
             info = QString("Superposition | Phenomenon: %1")
                    .arg(QString::fromStdString(m_waveEngine->detectPhenomenon()));
             break;
+        case VisualizationMode::SPECTROGRAM:
+            info = QString("Spectrogram | %1 Hz resolution")
+                   .arg(m_spectrum.getFrequencyResolution(), 0, 'g', 3);
+            break;
+        case VisualizationMode::INTERFERENCE_PATTERN:
+            info = QString("Interference Field | Sources: %1 | Spacing: %2 m%3")
+                   .arg(m_waveEngine->getWaveCount())
+                   .arg(m_sourceSpacing, 0, 'f', 2)
+                   .arg(m_heatmapBlock > 1 ? " | Refining..." : "");
+            break;
         default:
             info = "Wave Visualizer";
     }
@@ -380,6 +723,61 @@ void WaveVisualizer::drawMeasurements(QPainter &painter) {
     m_infoLabel->setText(info);
 }
 
+void WaveVisualizer::drawFrameStats(QPainter &painter) {
+    struct Channel {
+        const char* name;
+        const FrameTimeStats* stats;
+        QColor color;
+    };
+    const Channel channels[] = {
+        {"Frame", &m_frameStats, QColor(40, 120, 220)},
+        {"Generate", &m_generateStats, QColor(220, 120, 40)},
+        {"Paint", &m_paintStats, QColor(60, 160, 60)}
+    };
+    
+    const int rowHeight = 44;
+    const int histogramHeight = 22;
+    const int barWidth = 4;
+    int binCount = static_cast<int>(m_frameStats.getHistogram().size());
+    QRect box(m_plotRect.left() + 10, m_plotRect.top() + 10, binCount * barWidth + 20, 3 * rowHeight + 28);
+    
+    painter.save();
+    painter.setPen(Qt::black);
+    painter.setBrush(QBrush(QColor(255, 255, 255, 220)));
+    painter.drawRect(box);
+    
+    int y = box.top() + 4;
+    for (const Channel& channel : channels) {
+        const FrameTimeStats& stats = *channel.stats;
+        
+        painter.setPen(Qt::black);
+        painter.drawText(box.left() + 8, y + 12,
+                         QString("%1 %2 ms  p95 %3  max %4")
+                         .arg(QLatin1String(channel.name))
+                         .arg(stats.getLatest(), 0, 'f', 1)
+                         .arg(stats.getPercentile(0.95), 0, 'f', 1)
+                         .arg(stats.getMax(), 0, 'f', 1));
+        
+        // One bar per millisecond bin, scaled to the fullest bin
+        const auto& histogram = stats.getHistogram();
+        size_t tallest = std::max<size_t>(1, *std::max_element(histogram.begin(), histogram.end()));
+        int baseline = y + 16 + histogramHeight;
+        for (size_t bin = 0; bin < histogram.size(); ++bin) {
+            int height = static_cast<int>(histogramHeight * histogram[bin] / tallest);
+            if (height > 0) {
+                painter.fillRect(QRect(box.left() + 10 + static_cast<int>(bin) * barWidth, baseline - height,
+                                       barWidth - 1, height), channel.color);
+            }
+        }
+        
+        y += rowHeight;
+    }
+    
+    painter.setPen(Qt::black);
+    painter.drawText(box.left() + 8, y + 14, QString("Dropped frames: %1").arg(m_droppedFrames));
+    painter.restore();
+}
+
 QPointF WaveVisualizer::worldToScreen(double x, double y) const {
     if (m_plotRect.isEmpty()) return QPointF(0, 0);
     
@@ -398,15 +796,70 @@ QPointF WaveVisualizer::screenToWorld(const QPointF &screen) const {
     return QPointF(worldX, worldY);
 }
 
+void WaveVisualizer::toScreenPolyline(const std::vector<QPointF>& data, QPolygonF& polyline) const {
+    polyline.resize(static_cast<int>(data.size()));
+    if (m_plotRect.isEmpty()) return;
+    
+    // Same mapping as worldToScreen, with the scale factors hoisted out of the loop
+    double scaleX = m_plotRect.width() / (m_maxX - m_minX);
+    double scaleY = m_plotRect.height() / (m_maxY - m_minY);
+    double left = m_plotRect.left();
+    double bottom = m_plotRect.bottom();
+    
+    QPointF* points = polyline.data();
+    for (size_t i = 0; i < data.size(); ++i) {
+        points[i] = QPointF(left + (data[i].x() - m_minX) * scaleX,
+                            bottom - (data[i].y() - m_minY) * scaleY);
+    }
+}
+
+const QPainterPath& WaveVisualizer::cachedPath(const std::vector<QPointF>& data, size_t seriesIndex) {
+    bool transformChanged = m_pathMinX != m_minX || m_pathMaxX != m_maxX ||
+                            m_pathMinY != m_minY || m_pathMaxY != m_maxY ||
+                            m_pathRect != m_plotRect || m_pathVersion != m_plotVersion;
+    
+    if (transformChanged) {
+        m_pathCache.clear();
+        m_pathMinX = m_minX;
+        m_pathMaxX = m_maxX;
+        m_pathMinY = m_minY;
+        m_pathMaxY = m_maxY;
+        m_pathRect = m_plotRect;
+        m_pathVersion = m_plotVersion;
+    }
+    
+    if (seriesIndex >= m_pathCache.size()) {
+        m_pathCache.resize(seriesIndex + 1);
+    }
+    
+    CachedPath& entry = m_pathCache[seriesIndex];
+    if (!entry.valid) {
+        toScreenPolyline(data, m_polyline);
+        entry.path = QPainterPath();
+        entry.path.addPolygon(m_polyline);
+        entry.valid = true;
+    }
+    
+    return entry.path;
+}
+
 void WaveVisualizer::updateTransform() {
-    if (m_autoScale && m_waveEngine && !m_plotData.empty()) {
+    // The spectrum views set their own ranges when their data is generated
+    if (m_autoScale && m_waveEngine && !m_plotData.empty() && !scrollingView() &&
+        m_mode != VisualizationMode::FREQUENCY_DOMAIN && m_mode != VisualizationMode::SPECTROGRAM &&
+        m_mode != VisualizationMode::INTERFERENCE_PATTERN) {
         // Auto-scale Y axis based on data
         double minY = std::numeric_limits<double>::max();
         double maxY = std::numeric_limits<double>::lowest();
         
-        for (const auto& point : m_plotData) {
-            minY = std::min(minY, point.y());
-            maxY = std::max(maxY, point.y());
+        if (m_hasDataRange) {
+            minY = m_dataMinY;
+            maxY = m_dataMaxY;
+        } else {
+            for (const auto& point : m_plotData) {
+                minY = std::min(minY, point.y());
+                maxY = std::max(maxY, point.y());
+            }
         }
         
         double margin = (maxY - minY) * 0.1;
@@ -417,71 +870,508 @@ void WaveVisualizer::updateTransform() {
 }
 
 void WaveVisualizer::generateTimeData() {
-    if (!m_waveEngine) return;
+    requestPlotData(false);
+}
+
+void WaveVisualizer::advanceScrollingWindow() {
+    double window = m_maxX - m_minX;
+    if (window <= 0.0) return;
     
-    m_plotData.clear();
+    int columns = m_plotRect.width() > 0 ? m_plotRect.width() : DEFAULT_POINTS;
+    std::vector<double> waves = snapshotWaves();
     
-    double duration = m_maxX - m_minX;
-    int numPoints = static_cast<int>(std::min(duration * 100, static_cast<double>(DEFAULT_POINTS)));
-    double dt = duration / numPoints;
+    // Resizing, zooming or editing a wave invalidates every stored column
+    bool reset = m_scrollRing.isEmpty() || columns != m_scrollColumns || waves != m_scrollWaves ||
+                 std::abs(window - m_scrollWindow) > 1e-9 * window;
     
-    for (int i = 0; i <= numPoints; ++i) {
-        double t = m_minX + i * dt;
-        double amplitude = m_waveEngine->evaluateSuperposition(0.0, t);
-        m_plotData.emplace_back(t, amplitude);
+    if (reset) {
+        m_scrollColumns = columns;
+        m_scrollWindow = window;
+        m_scrollColumnTime = window / columns;
+        m_scrollWaves = std::move(waves);
+        m_scrollRing.resize(2 * columns);
+        
+        double maxFrequency = 0.0;
+        m_scrollBound = 0.0;
+        for (size_t i = 0; i + 3 < m_scrollWaves.size(); i += 4) {
+            m_scrollBound += std::abs(m_scrollWaves[i + 1]);
+            maxFrequency = std::max(maxFrequency, m_scrollWaves[i + 2]);
+        }
+        
+        double samples = std::ceil(maxFrequency * SAMPLES_PER_PERIOD * m_scrollColumnTime);
+        m_scrollSamples = static_cast<int>(std::min(std::max(samples, 2.0), static_cast<double>(MAX_SCROLL_SAMPLES)));
+    }
+    
+    // Sample only the columns that entered; seeking back or jumping further
+    // than the window refills all of them
+    long long latest = static_cast<long long>(std::floor(m_currentTime / m_scrollColumnTime));
+    if (reset || latest < m_scrollColumn || latest - m_scrollColumn > columns) {
+        m_scrollColumn = latest - columns;
+    }
+    
+    for (long long column = m_scrollColumn + 1; column <= latest; ++column) {
+        sampleScrollColumn(column);
+    }
+    m_scrollColumn = latest;
+    
+    m_maxX = (latest + 1) * m_scrollColumnTime;
+    m_minX = m_maxX - m_scrollWindow;
+    
+    // The sum of amplitudes bounds the signal without scanning the ring
+    if (m_autoScale) {
+        double bound = m_scrollBound > 0.0 ? m_scrollBound : 1.0;
+        m_minY = -1.1 * bound;
+        m_maxY = 1.1 * bound;
     }
+    
+    ++m_plotVersion;
 }
 
-void WaveVisualizer::generateFrequencyData() {
-    if (!m_waveEngine) return;
+void WaveVisualizer::sampleScrollColumn(long long column) {
+    double start = column * m_scrollColumnTime;
+    double dt = m_scrollColumnTime / m_scrollSamples;
     
-    // Generate time series for FFT
-    auto timeSeries = m_waveEngine->generateTimeSeries(DEFAULT_DURATION, 256.0);
+    double minY = std::numeric_limits<double>::max();
+    double maxY = std::numeric_limits<double>::lowest();
+    int minAt = 0, maxAt = 0;
+    for (int i = 0; i < m_scrollSamples; ++i) {
+        double value = m_waveEngine->evaluateSuperposition(0.0, start + i * dt);
+        if (value < minY) { minY = value; minAt = i; }
+        if (value > maxY) { maxY = value; maxAt = i; }
+    }
     
-    // Perform FFT (simplified - using dominant frequency approach)
-    m_spectrumData.clear();
+    // Keep the extrema in time order so the trace follows the signal
+    int columns = m_scrollColumns;
+    int slot = static_cast<int>((column % columns + columns) % columns);
+    QPointF* points = m_scrollRing.data() + 2 * slot;
+    points[0] = QPointF(slot, minAt <= maxAt ? minY : maxY);
+    points[1] = QPointF(slot, minAt <= maxAt ? maxY : minY);
+}
+
+void WaveVisualizer::requestHeatmap() {
+    if (!m_waveEngine || m_plotRect.isEmpty()) return;
     
-    for (size_t i = 0; i < m_waveEngine->getWaveCount(); ++i) {
-        const WaveFunction* wave = m_waveEngine->getWave(i);
-        if (wave) {
-            double freq = wave->getFrequency();
-            double amp = wave->getAmplitude();
-            m_spectrumData.emplace_back(freq, amp);
+    // Rebuild the sources only when the waves or the medium changed
+    std::vector<double> waves = snapshotWaves();
+    bool fieldChanged = waves != m_fieldWaves || m_field.getVelocity() != m_waveEngine->getVelocity();
+    
+    if (fieldChanged) {
+        m_field.clear();
+        m_field.setVelocity(m_waveEngine->getVelocity());
+        
+        size_t count = m_waveEngine->getWaveCount();
+        for (size_t i = 0; i < count; ++i) {
+            const WaveFunction* wave = m_waveEngine->getWave(i);
+            double y = (i - 0.5 * (count - 1)) * m_sourceSpacing;
+            if (wave) m_field.addSource(0.0, y, *wave);
         }
+        m_fieldWaves = std::move(waves);
+    }
+    
+    HeatmapView view;
+    view.minX = m_minX;
+    view.maxX = m_maxX;
+    view.minY = m_minY;
+    view.maxY = m_maxY;
+    view.width = m_plotRect.width();
+    view.height = m_plotRect.height();
+    
+    if (!fieldChanged && m_hasHeatmapRequest && view == m_heatmapRequest) return;
+    m_heatmapRequest = view;
+    m_hasHeatmapRequest = true;
+    m_rasterizer.render(m_field, view);
+}
+
+void WaveVisualizer::takeHeatmap() {
+    int block = m_rasterizer.takeImage(m_heatmapPixels, m_heatmapView);
+    if (block == 0) return;
+    
+    m_heatmapBlock = block;
+    m_heatmapImage = QImage(reinterpret_cast<const uchar*>(m_heatmapPixels.data()),
+                            m_heatmapView.width, m_heatmapView.height,
+                            m_heatmapView.width * static_cast<int>(sizeof(uint32_t)), QImage::Format_RGB32);
+    update();
+}
+
+void WaveVisualizer::generateFrequencyData() {
+    if (!m_waveEngine) return;
+    
+    if (advanceSpectrum()) {
+        // Display values, reduced through pyramids so panning needs no new FFT
+        bool logarithmic = (m_spectrumScale == SpectrumScale::LOGARITHMIC);
+        auto toDisplay = [&](const std::vector<double>& magnitudes, MinMaxPyramid& pyramid) {
+            m_spectrumValues.resize(magnitudes.size());
+            for (size_t k = 0; k < magnitudes.size(); ++k) {
+                m_spectrumValues[k] = logarithmic
+                    ? std::max(SPECTRUM_FLOOR_DB, 20.0 * std::log10(std::max(magnitudes[k], 1e-300)))
+                    : magnitudes[k];
+            }
+            pyramid.build(m_spectrumValues, 0.0, m_spectrum.getFrequencyResolution());
+        };
+        toDisplay(m_spectrum.getMagnitudes(), m_spectrumPyramid);
+        toDisplay(m_spectrum.getPeakHold(), m_peakPyramid);
+        m_spectrumViewColumns = 0;
     }
     
     // Set appropriate frequency range
-    if (m_autoScale && !m_spectrumData.empty()) {
+    if (m_autoScale && m_waveEngine->getWaveCount() > 0) {
+        double maxAmplitude = m_waveEngine->getMaxAmplitude();
         m_minX = 0;
         m_maxX = m_waveEngine->getDominantFrequency() * 5;
-        m_minY = 0;
-        m_maxY = m_waveEngine->getMaxAmplitude() * 1.2;
+        
+        if (m_spectrumScale == SpectrumScale::LOGARITHMIC) {
+            m_minY = SPECTRUM_FLOOR_DB;
+            m_maxY = 20.0 * std::log10(std::max(maxAmplitude, 1e-6)) + 10.0;
+        } else {
+            m_minY = 0;
+            m_maxY = maxAmplitude * 1.2;
+        }
     }
+    
+    decimateSpectrum();
+}
+
+void WaveVisualizer::generateSpectrogramData() {
+    if (!m_waveEngine) return;
+    
+    // Frequency across, update count down (newest at the top)
+    if (m_autoScale && m_waveEngine->getWaveCount() > 0) {
+        m_minX = 0;
+        m_maxX = m_waveEngine->getDominantFrequency() * 5;
+    }
+    m_minY = -WATERFALL_ROWS;
+    m_maxY = 0;
+    
+    if (advanceSpectrum()) appendWaterfallRow();
+}
+
+bool WaveVisualizer::advanceSpectrum() {
+    // Sample fast enough to resolve the harmonics of the fastest wave
+    std::vector<double> waves = snapshotWaves();
+    double maxFrequency = 0.0;
+    for (size_t i = 2; i < waves.size(); i += 4) {
+        maxFrequency = std::max(maxFrequency, waves[i]);
+    }
+    double sampleRate = std::max(SPECTRUM_MIN_RATE, maxFrequency * SAMPLES_PER_PERIOD);
+    
+    // Restart the stream with a full window ending now when the waves change
+    // or time jumps; otherwise only the samples since the last tick are new
+    double windowDuration = SPECTRUM_SIZE / sampleRate;
+    double streamEnd = m_spectrumStart + m_spectrumSamples / m_spectrum.getSampleRate();
+    bool restart = waves != m_spectrumWaves || sampleRate != m_spectrum.getSampleRate() ||
+                   m_currentTime < streamEnd || m_currentTime - streamEnd > windowDuration;
+    
+    if (restart) {
+        m_spectrum.configure(SPECTRUM_SIZE, sampleRate);
+        m_spectrumWaves = waves;
+        m_spectrumStart = m_currentTime - windowDuration;
+        m_spectrumSamples = 0;
+    }
+    
+    size_t target = static_cast<size_t>(std::floor((m_currentTime - m_spectrumStart) * sampleRate));
+    if (target <= m_spectrumSamples && !restart) return false;
+    
+    m_spectrumChunk.resize(SPECTRUM_CHUNK);
+    while (m_spectrumSamples < target) {
+        size_t count = std::min(SPECTRUM_CHUNK, target - m_spectrumSamples);
+        for (size_t i = 0; i < count; ++i) {
+            double t = m_spectrumStart + (m_spectrumSamples + i) / sampleRate;
+            m_spectrumChunk[i] = m_waveEngine->evaluateSuperposition(0.0, t);
+        }
+        m_spectrum.pushSamples(m_spectrumChunk.data(), count);
+        m_spectrumSamples += count;
+    }
+    
+    m_spectrum.update();
+    return true;
+}
+
+void WaveVisualizer::appendWaterfallRow() {
+    if (m_maxX <= m_minX) return;
+    
+    // History drawn for another frequency range would be misleading
+    if (m_waterfall.isNull() || m_waterfallMinX != m_minX || m_waterfallMaxX != m_maxX) {
+        m_waterfall = QImage(WATERFALL_BINS, WATERFALL_ROWS, QImage::Format_RGB32);
+        m_waterfall.fill(m_colormap[0]);
+        m_waterfallHead = 0;
+        m_waterfallMinX = m_minX;
+        m_waterfallMaxX = m_maxX;
+    }
+    
+    m_waterfallHead = (m_waterfallHead + WATERFALL_ROWS - 1) % WATERFALL_ROWS;
+    QRgb* line = reinterpret_cast<QRgb*>(m_waterfall.scanLine(m_waterfallHead));
+    
+    // Color by level below the strongest possible component
+    const auto& magnitudes = m_spectrum.getMagnitudes();
+    double binWidth = m_spectrum.getFrequencyResolution();
+    double binsPerPixel = (m_maxX - m_minX) / binWidth / WATERFALL_BINS;
+    double topDb = 20.0 * std::log10(std::max(m_waveEngine->getMaxAmplitude(), 1e-6));
+    double scale = (m_colormap.size() - 1) / WATERFALL_RANGE_DB;
+    
+    for (int c = 0; c < WATERFALL_BINS; ++c) {
+        double firstBin = m_minX / binWidth + c * binsPerPixel;
+        size_t k0 = static_cast<size_t>(std::max(0.0, std::floor(firstBin)));
+        size_t k1 = static_cast<size_t>(std::max(0.0, std::ceil(firstBin + binsPerPixel)));
+        k1 = std::min(std::max(k1, k0 + 1), magnitudes.size());
+        
+        double peak = 0.0;
+        for (size_t k = k0; k < k1; ++k) {
+            peak = std::max(peak, magnitudes[k]);
+        }
+        
+        double level = 20.0 * std::log10(std::max(peak, 1e-300)) - (topDb - WATERFALL_RANGE_DB);
+        int index = static_cast<int>(std::min(std::max(level * scale, 0.0), static_cast<double>(m_colormap.size() - 1)));
+        line[c] = m_colormap[index];
+    }
+    
+    update();
+}
+
+void WaveVisualizer::buildColormap() {
+    // Black through blue, red and orange to pale yellow
+    const double stops[][3] = {
+        {0, 0, 0}, {40, 0, 120}, {200, 30, 60}, {255, 160, 0}, {255, 255, 200}
+    };
+    const int numStops = 5;
+    
+    m_colormap.resize(256);
+    for (int i = 0; i < 256; ++i) {
+        double position = i / 255.0 * (numStops - 1);
+        int stop = std::min(static_cast<int>(position), numStops - 2);
+        double t = position - stop;
+        
+        int r = static_cast<int>(stops[stop][0] + t * (stops[stop + 1][0] - stops[stop][0]));
+        int g = static_cast<int>(stops[stop][1] + t * (stops[stop + 1][1] - stops[stop][1]));
+        int b = static_cast<int>(stops[stop][2] + t * (stops[stop + 1][2] - stops[stop][2]));
+        m_colormap[i] = qRgb(r, g, b);
+    }
+}
+
+void WaveVisualizer::decimateSpectrum() {
+    int columns = m_plotRect.width() > 0 ? m_plotRect.width() : DEFAULT_POINTS;
+    if (m_spectrumViewColumns == columns && m_spectrumViewMinX == m_minX && m_spectrumViewMaxX == m_maxX) return;
+    
+    m_spectrumViewMinX = m_minX;
+    m_spectrumViewMaxX = m_maxX;
+    m_spectrumViewColumns = columns;
+    
+    auto decimate = [&](const MinMaxPyramid& pyramid, std::vector<QPointF>& output) {
+        pyramid.decimate(m_minX, m_maxX, columns, m_spectrumX, m_spectrumY);
+        output.resize(m_spectrumX.size());
+        for (size_t i = 0; i < m_spectrumX.size(); ++i) {
+            output[i] = QPointF(m_spectrumX[i], m_spectrumY[i]);
+        }
+    };
+    
+    decimate(m_spectrumPyramid, m_spectrumData);
+    decimate(m_peakPyramid, m_peakHoldData);
+    ++m_plotVersion;
 }
 
 void WaveVisualizer::generateSuperpositionData() {
+    requestPlotData(true);
+}
+
+std::vector<double> WaveVisualizer::snapshotWaves() const {
+    std::vector<double> waves;
+    if (!m_waveEngine) return waves;
+    
+    waves.reserve(4 * m_waveEngine->getWaveCount());
+    for (size_t i = 0; i < m_waveEngine->getWaveCount(); ++i) {
+        const WaveFunction* wave = m_waveEngine->getWave(i);
+        if (!wave) continue;
+        
+        waves.push_back(static_cast<double>(wave->getType()));
+        waves.push_back(wave->getAmplitude());
+        waves.push_back(wave->getFrequency());
+        waves.push_back(wave->getPhase());
+    }
+    
+    return waves;
+}
+
+void WaveVisualizer::requestPlotData(bool perWave) {
     if (!m_waveEngine) return;
     
-    // Generate individual wave data
-    m_multiWaveData.clear();
+    PlotRequest request;
+    request.minX = m_minX;
+    request.maxX = m_maxX;
+    request.columns = m_plotRect.width() > 0 ? m_plotRect.width() : DEFAULT_POINTS;
+    request.perWave = perWave;
+    
+    // Snapshot the wave parameters; the worker never touches m_waveEngine
+    request.waves = snapshotWaves();
+    
+    // Animation ticks usually leave the view unchanged, so most calls stop here
+    if (m_hasLastRequest && request == m_lastRequest) return;
+    m_lastRequest = request;
+    m_hasLastRequest = true;
+    m_awaitingFrame = true;
+    request.serial = ++m_requestSerial;
     
-    double duration = m_maxX - m_minX;
-    int numPoints = static_cast<int>(std::min(duration * 100, static_cast<double>(DEFAULT_POINTS)));
-    double dt = duration / numPoints;
+    {
+        std::lock_guard<std::mutex> lock(m_workerMutex);
+        m_pendingRequest = std::move(request);
+        m_hasPendingRequest = true;   // Replaces any request the worker has not started
+    }
+    m_workerCondition.notify_one();
+}
+
+void WaveVisualizer::swapPlotData() {
+    {
+        std::lock_guard<std::mutex> lock(m_workerMutex);
+        if (!m_frameReady) return;    // An earlier queued swap already took it
+        
+        std::swap(m_plotData, m_readyFrame.plotData);
+        std::swap(m_multiWaveData, m_readyFrame.multiWaveData);
+        m_dataMinY = m_readyFrame.minY;
+        m_dataMaxY = m_readyFrame.maxY;
+        m_hasDataRange = m_readyFrame.hasRange;
+        m_frameReady = false;
+        
+        m_generateStats.record(m_readyFrame.generationMs);
+        if (m_readyFrame.serial == m_requestSerial) m_awaitingFrame = false;
+    }
     
-    for (size_t waveIdx = 0; waveIdx < m_waveEngine->getWaveCount(); ++waveIdx) {
-        std::vector<QPointF> waveData;
+    ++m_plotVersion;
+    updateTransform();
+    update();
+}
+
+void WaveVisualizer::stopWorker() {
+    {
+        std::lock_guard<std::mutex> lock(m_workerMutex);
+        m_stopWorker = true;
+    }
+    m_workerCondition.notify_one();
+    
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+void WaveVisualizer::workerLoop() {
+    while (true) {
+        PlotRequest request;
+        {
+            std::unique_lock<std::mutex> lock(m_workerMutex);
+            m_workerCondition.wait(lock, [this]() { return m_stopWorker || m_hasPendingRequest; });
+            if (m_stopWorker) return;
+            
+            request = std::move(m_pendingRequest);
+            m_hasPendingRequest = false;
+        }
+        
+        auto started = std::chrono::steady_clock::now();
+        if (needsNewDataSet(request)) buildDataSet(request);
+        decimateInto(request, m_backFrame);
+        
+        m_backFrame.serial = request.serial;
+        m_backFrame.generationMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - started).count();
         
-        for (int i = 0; i <= numPoints; ++i) {
-            double t = m_minX + i * dt;
-            double amplitude = m_waveEngine->evaluateWave(waveIdx, 0.0, t);
-            waveData.emplace_back(t, amplitude);
+        {
+            std::lock_guard<std::mutex> lock(m_workerMutex);
+            
+            // A newer request arrived while this frame was built; skip straight to it
+            if (m_hasPendingRequest) continue;
+            
+            // The old ready buffers come back as the next back buffer
+            std::swap(m_readyFrame, m_backFrame);
+            m_frameReady = true;
         }
         
-        m_multiWaveData.push_back(waveData);
+        QMetaObject::invokeMethod(this, [this]() { swapPlotData(); }, Qt::QueuedConnection);
     }
+}
+
+bool WaveVisualizer::needsNewDataSet(const PlotRequest& request) const {
+    if (m_signalPyramid.isEmpty()) return true;
+    if (request.waves != m_dataWaves) return true;
+    if (request.perWave && m_wavePyramids.size() != request.waves.size() / 4) return true;
+    if (request.minX < m_signalPyramid.getStartX() || request.maxX > m_signalPyramid.getEndX()) return true;
     
-    // Generate superposition
-    generateTimeData();
+    // Zoomed in past the sampled resolution: less than one sample per two pixels
+    double range = request.maxX - request.minX;
+    return range > 0.0 && m_dataRate * range < 0.5 * request.columns &&
+           m_signalPyramid.getSampleCount() < MAX_DATA_SAMPLES / 2;
 }
 
+void WaveVisualizer::buildDataSet(const PlotRequest& request) {
+    double range = request.maxX - request.minX;
+    if (range <= 0.0) return;
+    
+    // Rebuild the private engine only when the wave parameters changed
+    if (request.waves != m_dataWaves) {
+        m_workerEngine.clearWaves();
+        for (size_t i = 0; i + 3 < request.waves.size(); i += 4) {
+            WaveType type = static_cast<WaveType>(static_cast<int>(request.waves[i]));
+            double amplitude = request.waves[i + 1];
+            double frequency = request.waves[i + 2];
+            double phase = request.waves[i + 3];
+            
+            m_workerEngine.addWave(WaveFunction::create(type, amplitude, frequency, phase));
+        }
+        m_dataWaves = request.waves;
+    }
+    
+    // Sample three view widths so panning and moderate zooming reuse the set
+    double maxFrequency = 0.0;
+    for (size_t i = 0; i < m_workerEngine.getWaveCount(); ++i) {
+        maxFrequency = std::max(maxFrequency, m_workerEngine.getWave(i)->getFrequency());
+    }
+    
+    double span = 3.0 * range;
+    double rate = std::max(maxFrequency * SAMPLES_PER_PERIOD, 2.0 * request.columns / range);
+    rate = std::min(rate, static_cast<double>(MAX_DATA_SAMPLES) / span);
+    
+    size_t numSamples = std::max<size_t>(static_cast<size_t>(span * rate) + 1, 2);
+    double start = request.minX - range;
+    double dt = span / (numSamples - 1);
+    
+    std::vector<double> samples(numSamples, 0.0);
+    m_wavePyramids.clear();
+    
+    if (request.perWave) {
+        // Sum the per-wave samples rather than evaluating the superposition again
+        std::vector<double> waveSamples(numSamples);
+        m_wavePyramids.resize(m_workerEngine.getWaveCount());
+        
+        for (size_t waveIdx = 0; waveIdx < m_wavePyramids.size(); ++waveIdx) {
+            for (size_t i = 0; i < numSamples; ++i) {
+                waveSamples[i] = m_workerEngine.evaluateWave(waveIdx, 0.0, start + i * dt);
+                samples[i] += waveSamples[i];
+            }
+            m_wavePyramids[waveIdx].build(waveSamples, start, dt);
+        }
+    } else {
+        for (size_t i = 0; i < numSamples; ++i) {
+            samples[i] = m_workerEngine.evaluateSuperposition(0.0, start + i * dt);
+        }
+    }
+    
+    m_signalPyramid.build(samples, start, dt);
+    m_dataRate = 1.0 / dt;
+}
+
+void WaveVisualizer::decimateInto(const PlotRequest& request, PlotFrame& frame) {
+    auto decimate = [&](const MinMaxPyramid& pyramid, std::vector<QPointF>& output) {
+        pyramid.decimate(request.minX, request.maxX, request.columns, m_decimatedX, m_decimatedY);
+        output.resize(m_decimatedX.size());
+        for (size_t i = 0; i < m_decimatedX.size(); ++i) {
+            output[i] = QPointF(m_decimatedX[i], m_decimatedY[i]);
+        }
+    };
+    
+    decimate(m_signalPyramid, frame.plotData);
+    frame.hasRange = m_signalPyramid.findRange(request.minX, request.maxX, frame.minY, frame.maxY);
+    
+    if (request.perWave) {
+        frame.multiWaveData.resize(m_wavePyramids.size());
+        for (size_t waveIdx = 0; waveIdx < m_wavePyramids.size(); ++waveIdx) {
+            decimate(m_wavePyramids[waveIdx], frame.multiWaveData[waveIdx]);
+        }
+    } else {
+        frame.multiWaveData.clear();
+    }
+}
@@ -6,19 +6,39 @@
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QFrame>
+#include <QtWidgets/QCheckBox>
 #include <QtGui/QPainter>
 #include <QtGui/QPen>
+#include <QtGui/QPolygonF>
+#include <QtGui/QPainterPath>
+#include <QtGui/QImage>
+#include <QtGui/QPixmap>
 #include <QtGui/QMouseEvent>
 #include <QtGui/QWheelEvent>
 #include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "WaveEngine.h"
+#include "MinMaxPyramid.h"
+#include "StreamingSpectrum.h"
+#include "FrameTimeStats.h"
+#include "InterferenceField.h"
+#include "HeatmapRasterizer.h"
 
 enum class VisualizationMode {
     TIME_DOMAIN,
     FREQUENCY_DOMAIN,
     SUPERPOSITION,
-    INTERFERENCE_PATTERN
+    INTERFERENCE_PATTERN,
+    SPECTROGRAM
+};
+
+enum class SpectrumScale {
+    LINEAR,
+    LOGARITHMIC
 };
 
 class WaveVisualizer : public QWidget {
@@ -34,11 +54,38 @@ public:
     void setCurrentTime(double time);
     void updateVisualization();
     
+    // Deferred updates: invalidate() marks the data stale and, if the widget
+    // is visible, queues a single refresh; hidden widgets refresh when shown
+    void invalidate();
+    void refresh();
+    bool isDirty() const { return m_dirty; }
+    
+    // True while a requested frame has not been produced yet
+    bool isBusy() const { return m_dirty || m_awaitingFrame; }
+    
+    // Timing overlay: frame interval, data generation and paint histograms
+    void setShowFrameStats(bool show) { m_showFrameStats = show; update(); }
+    void recordDroppedFrame() { ++m_droppedFrames; }
+    
     // Display properties
     void setShowGrid(bool show) { m_showGrid = show; update(); }
     void setShowLegend(bool show) { m_showLegend = show; update(); }
     void setShowAxes(bool show) { m_showAxes = show; update(); }
     void setAutoScale(bool enable) { m_autoScale = enable; }
+    void setCachePaths(bool enable) { m_cachePaths = enable; m_pathCache.clear(); update(); }
+    
+    // Scrolling time window: the time view ends at the current time and each
+    // frame samples only the columns that scrolled in since the last one
+    void setScrolling(bool enable);
+    bool isScrolling() const { return m_scrolling; }
+    
+    // Interference field: waves become point sources spaced along the y axis
+    void setSourceSpacing(double spacing);
+    
+    // Spectrum display
+    void setSpectrumScale(SpectrumScale scale);
+    void setShowPeakHold(bool show);
+    void resetPeakHold();
     
 public:
     void onWaveDataChanged();
@@ -50,6 +97,7 @@ protected:
     void mouseMoveEvent(QMouseEvent *event) override;
     void wheelEvent(QWheelEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
 
 private:
     void setupUI();
@@ -58,25 +106,86 @@ private:
     void drawWaveform(QPainter &painter);
     void drawSpectrum(QPainter &painter);
     void drawSuperposition(QPainter &painter);
+    void drawSpectrogram(QPainter &painter);
+    void drawSeries(QPainter &painter, const std::vector<QPointF>& data, size_t seriesIndex);
+    void drawScrollingWaveform(QPainter &painter);
+    void drawInterferencePattern(QPainter &painter);
     void drawLegend(QPainter &painter);
+    QRect legendRect() const;
+    void updateStaticLayers();
+    void updateCursorRegion(const QPointF &screenPos);
     void drawCursor(QPainter &painter);
     void drawMeasurements(QPainter &painter);
+    void drawFrameStats(QPainter &painter);
     
     // Coordinate transformation
     QPointF worldToScreen(double x, double y) const;
     QPointF screenToWorld(const QPointF &screen) const;
     void updateTransform();
+    void toScreenPolyline(const std::vector<QPointF>& data, QPolygonF& polyline) const;
+    const QPainterPath& cachedPath(const std::vector<QPointF>& data, size_t seriesIndex);
     
     // Data generation
     void generateTimeData();
     void generateFrequencyData();
     void generateSuperpositionData();
+    void generateSpectrogramData();
+    std::vector<double> snapshotWaves() const;
+    bool advanceSpectrum();
+    void decimateSpectrum();
+    void appendWaterfallRow();
+    bool scrollingView() const { return m_scrolling && m_mode == VisualizationMode::TIME_DOMAIN; }
+    void advanceScrollingWindow();
+    void sampleScrollColumn(long long column);
+    void requestHeatmap();
+    void takeHeatmap();
+    void buildColormap();
+    
+    // Level-of-detail data is produced on a worker thread. The GUI thread
+    // posts only the latest request; the worker samples the signal into
+    // min/max pyramids once per data set, reduces the view to ~2 points per
+    // pixel column and hands the frame back for a swap.
+    struct PlotRequest {
+        std::vector<double> waves;      // (type, amplitude, frequency, phase) per wave
+        double minX = 0.0;
+        double maxX = 0.0;
+        int columns = 0;
+        bool perWave = false;
+        size_t serial = 0;              // Not part of equality
+        
+        bool operator==(const PlotRequest& other) const {
+            return waves == other.waves && minX == other.minX && maxX == other.maxX &&
+                   columns == other.columns && perWave == other.perWave;
+        }
+    };
+    
+    struct PlotFrame {
+        std::vector<QPointF> plotData;
+        std::vector<std::vector<QPointF>> multiWaveData;
+        double minY = 0.0;
+        double maxY = 0.0;
+        bool hasRange = false;
+        double generationMs = 0.0;
+        size_t serial = 0;
+    };
+    
+    void requestPlotData(bool perWave);
+    void swapPlotData();
+    void stopWorker();
+    void workerLoop();
+    
+    // Worker thread only
+    bool needsNewDataSet(const PlotRequest& request) const;
+    void buildDataSet(const PlotRequest& request);
+    void decimateInto(const PlotRequest& request, PlotFrame& frame);
     
     // UI components
     QVBoxLayout *m_layout;
     QFrame *m_plotFrame;
     QHBoxLayout *m_infoLayout;
     QLabel *m_infoLabel;
+    QCheckBox *m_logScaleCheck;
+    QCheckBox *m_peakHoldCheck;
     
     // Core data
     WaveEngine *m_waveEngine;
@@ -87,10 +196,122 @@ private:
     std::vector<QPointF> m_spectrumData;
     std::vector<std::vector<QPointF>> m_multiWaveData;
     
+    size_t m_plotVersion;           // Bumped whenever m_plotData or m_multiWaveData change
+    double m_dataMinY, m_dataMaxY;  // Extrema of the visible data, for auto-scaling
+    bool m_hasDataRange;
+    
+    // Worker hand-off, guarded by m_workerMutex
+    std::mutex m_workerMutex;
+    std::condition_variable m_workerCondition;
+    PlotRequest m_pendingRequest;
+    PlotFrame m_readyFrame;
+    bool m_hasPendingRequest;
+    bool m_frameReady;
+    bool m_stopWorker;
+    PlotRequest m_lastRequest;      // GUI thread: the most recent request posted
+    bool m_hasLastRequest;
+    bool m_awaitingFrame;
+    size_t m_requestSerial;
+    
+    // Worker-owned state: a private copy of the waves and the pyramids built from it
+    WaveEngine m_workerEngine;
+    std::vector<double> m_dataWaves;
+    MinMaxPyramid m_signalPyramid;
+    std::vector<MinMaxPyramid> m_wavePyramids;
+    double m_dataRate;
+    std::vector<double> m_decimatedX;
+    std::vector<double> m_decimatedY;
+    PlotFrame m_backFrame;
+    std::thread m_worker;
+    
+    // Spectrum: a streaming STFT fed only the samples since the last update,
+    // then reduced per pixel column like the time-domain series
+    StreamingSpectrum m_spectrum;
+    std::vector<double> m_spectrumWaves;
+    double m_spectrumStart;         // Time of sample 0 of the stream
+    size_t m_spectrumSamples;       // Samples pushed since m_spectrumStart
+    std::vector<double> m_spectrumChunk;
+    std::vector<double> m_spectrumValues;
+    MinMaxPyramid m_spectrumPyramid;
+    MinMaxPyramid m_peakPyramid;
+    std::vector<double> m_spectrumX;
+    std::vector<double> m_spectrumY;
+    std::vector<QPointF> m_peakHoldData;
+    double m_spectrumViewMinX, m_spectrumViewMaxX;
+    int m_spectrumViewColumns;
+    SpectrumScale m_spectrumScale;
+    bool m_showPeakHold;
+    
+    // Spectrogram: a ring of spectrum rows, newest at m_waterfallHead. A new
+    // STFT writes one scanline; painting blits the ring in two pieces.
+    QImage m_waterfall;
+    int m_waterfallHead;
+    double m_waterfallMinX, m_waterfallMaxX;
+    std::vector<QRgb> m_colormap;
+    
+    // Scrolling window: a min/max pair per pixel column in a ring indexed by
+    // absolute column number modulo the width. m_scrollColumn is the newest
+    // column sampled; painting splits the ring there instead of moving data.
+    bool m_scrolling;
+    QPolygonF m_scrollRing;
+    std::vector<double> m_scrollWaves;
+    int m_scrollColumns;
+    long long m_scrollColumn;
+    double m_scrollWindow;
+    double m_scrollColumnTime;
+    int m_scrollSamples;            // Evaluations per column
+    double m_scrollBound;           // Sum of amplitudes, for auto-scaling
+    
+    // Interference field: rendered in coarse-to-fine passes off the GUI
+    // thread. The newest pass is drawn at the view it was rendered for, so
+    // panning and zooming move it until a pass for the new view arrives.
+    HeatmapRasterizer m_rasterizer;
+    InterferenceField m_field;
+    std::vector<double> m_fieldWaves;
+    double m_sourceSpacing;
+    HeatmapView m_heatmapRequest;   // Last view sent to the rasterizer
+    bool m_hasHeatmapRequest;
+    std::vector<uint32_t> m_heatmapPixels;
+    QImage m_heatmapImage;          // Wraps m_heatmapPixels
+    HeatmapView m_heatmapView;
+    int m_heatmapBlock;
+    
+    // Static layers: background, grid and axes in one pixmap and the legend
+    // in another, re-rendered only when what they depict changes
+    QPixmap m_staticLayer;
+    QPixmap m_legendLayer;
+    double m_layerMinX, m_layerMaxX, m_layerMinY, m_layerMaxY;
+    QSize m_layerSize;
+    bool m_layerGrid, m_layerAxes;
+    std::vector<double> m_legendWaves;
+    QRect m_legendRect;
+    
+    // Series rendering: one reusable screen-space buffer, plus screen-space
+    // paths kept while neither the transform nor the data changes
+    struct CachedPath {
+        QPainterPath path;
+        bool valid = false;
+    };
+    QPolygonF m_polyline;
+    std::vector<CachedPath> m_pathCache;
+    double m_pathMinX, m_pathMaxX, m_pathMinY, m_pathMaxY;
+    QRect m_pathRect;
+    size_t m_pathVersion;
+    
     // Display ranges
     double m_minX, m_maxX;
     double m_minY, m_maxY;
     double m_currentTime;
+    bool m_dirty;
+    bool m_refreshPending;
+    
+    // Timing instrumentation
+    FrameTimeStats m_frameStats;
+    FrameTimeStats m_generateStats;
+    FrameTimeStats m_paintStats;
+    QElapsedTimer m_frameClock;
+    size_t m_droppedFrames;
+    bool m_showFrameStats;
     
     // Display properties
     bool m_showGrid;
@@ -98,6 +319,7 @@ private:
     bool m_showAxes;
     bool m_autoScale;
     bool m_showCursor;
+    bool m_cachePaths;
     
     // Interaction
     bool m_isPanning;
@@ -121,6 +343,16 @@ private:
     static constexpr int DEFAULT_POINTS = 1000;
     static constexpr double DEFAULT_DURATION = 5.0;
     static constexpr double ZOOM_FACTOR = 1.2;
+    static constexpr double SAMPLES_PER_PERIOD = 64.0;
+    static constexpr size_t MAX_DATA_SAMPLES = size_t(1) << 22;
+    static constexpr int MAX_SCROLL_SAMPLES = 64;
+    static constexpr size_t SPECTRUM_SIZE = 65536;
+    static constexpr size_t SPECTRUM_CHUNK = 4096;
+    static constexpr double SPECTRUM_MIN_RATE = 256.0;
+    static constexpr double SPECTRUM_FLOOR_DB = -120.0;
+    static constexpr int WATERFALL_BINS = 512;
+    static constexpr int WATERFALL_ROWS = 256;
+    static constexpr double WATERFALL_RANGE_DB = 100.0;
 };
 
 #endif // WAVE_VISUALIZER_H
\ No newline at end of file
@@ -4,6 +4,11 @@
 #include "WaveEngine.h"
 #include "FourierAnalyzer.h"
 #include "InterferenceCalculator.h"
+#include "DiffractionCalculator.h"
+#include "FresnelPropagator.h"
+#include "PhysicsConstants.h"
+#include <cmath>
+#include "ScenarioFile.h"
 
 void demonstrateBasicWaves() {
     std::cout << "=== Basic Wave Demonstration ===" << std::endl;
@@ -116,7 +121,148 @@ void demonstrateFourierAnalysis() {
     std::cout << "Total Harmonic Distortion: " << thd << "%" << std::endl;
 }
 
-int main() {
+void demonstrateDiffraction() {
+    std::cout << std::endl << "=== Fraunhofer Diffraction Demonstration ===" << std::endl;
+    
+    DiffractionCalculator calculator;
+    
+    // Five-slit grating: 20 um slits, 100 um apart, sampled every 1 um
+    double spacing = 1e-6;
+    double wavelength = 500e-9;
+    auto grating = calculator.createGratingAperture(5, 20e-6, 100e-6, spacing, 1024);
+    auto pattern = calculator.calculateFraunhoferPattern(grating, spacing, wavelength, 1.0, 8);
+    
+    std::cout << "Five-slit grating, lambda = 500 nm, screen at 1 m" << std::endl;
+    std::cout << "Screen samples: " << pattern.positions.size() << std::endl;
+    std::cout << "Expected principal maximum spacing: " << wavelength / 100e-6 * 1000.0 << " mm" << std::endl;
+    
+    // First principal maximum away from the center
+    for (size_t i = 1; i + 1 < pattern.positions.size(); ++i) {
+        if (pattern.positions[i] > 1e-3 && pattern.intensity[i] > 0.5 &&
+            pattern.intensity[i] >= pattern.intensity[i - 1] && pattern.intensity[i] >= pattern.intensity[i + 1]) {
+            std::cout << "First-order maximum found at: " << pattern.positions[i] * 1000.0 << " mm" << std::endl;
+            break;
+        }
+    }
+}
+
+void demonstrateFresnelPropagation() {
+    std::cout << std::endl << "=== Fresnel Propagation Demonstration ===" << std::endl;
+    
+    FresnelPropagator propagator;
+    
+    // Cosine amplitude grating, period 32 um, sampled every 1 um (8 periods across the grid)
+    const size_t rows = 8;
+    const size_t cols = 256;
+    double spacing = 1e-6;
+    double period = 32e-6;
+    double wavelength = 500e-9;
+    
+    std::vector<double> grating(rows * cols);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            grating[r * cols + c] = 0.5 * (1.0 + std::cos(Physics::TWO_PI * c * spacing / period));
+        }
+    }
+    
+    OpticalField field = propagator.createField(grating, rows, cols, spacing);
+    auto input = propagator.calculateIntensity(field);
+    
+    // The grating re-images itself at the Talbot distance 2d^2/lambda, and again
+    // shifted by half a period at half that distance
+    double talbotDistance = 2.0 * period * period / wavelength;
+    size_t halfPeriod = static_cast<size_t>(period / spacing) / 2;
+    
+    std::cout << "Cosine grating, period 32 um, lambda = 500 nm" << std::endl;
+    std::cout << "Talbot distance: " << talbotDistance * 1000.0 << " mm" << std::endl;
+    
+    auto maxDeviation = [&](const std::vector<double>& intensity, size_t shift) {
+        double deviation = 0.0;
+        for (size_t r = 0; r < rows; ++r) {
+            for (size_t c = 0; c < cols; ++c) {
+                double expected = input[r * cols + (c + shift) % cols];
+                deviation = std::max(deviation, std::abs(intensity[r * cols + c] - expected));
+            }
+        }
+        return deviation;
+    };
+    
+    const PropagationMethod methods[] = {PropagationMethod::FRESNEL_TRANSFER, PropagationMethod::ANGULAR_SPECTRUM};
+    const char* names[] = {"Fresnel transfer", "Angular spectrum"};
+    
+    for (int m = 0; m < 2; ++m) {
+        auto planes = propagator.propagateSweep(field, wavelength, {talbotDistance / 2.0, talbotDistance}, methods[m]);
+        
+        std::cout << names[m] << ": max intensity error "
+                  << maxDeviation(propagator.calculateIntensity(planes[1]), 0) << " at the Talbot plane, "
+                  << maxDeviation(propagator.calculateIntensity(planes[0]), halfPeriod) << " at half distance (shifted)"
+                  << std::endl;
+    }
+}
+
+// Loads a scenario file and runs its analysis steps in order
+int runScenario(const std::string& path) {
+    ScenarioFile file;
+    Scenario scenario;
+    if (!file.load(path, scenario)) {
+        std::cerr << "Error: " << file.getError() << std::endl;
+        return 1;
+    }
+    
+    WaveEngine engine;
+    ScenarioFile::apply(scenario, engine);
+    
+    std::cout << "=== Scenario: " << (scenario.name.empty() ? path : scenario.name) << " ===" << std::endl;
+    std::cout << "Waves: " << engine.getWaveCount() << ", velocity: " << engine.getVelocity() << " m/s" << std::endl;
+    std::cout << "Sampling: " << scenario.sampleRate << " Hz for " << scenario.duration
+              << " s at x=" << scenario.position << "m" << std::endl;
+    
+    auto signal = engine.generateTimeSeries(scenario.duration, scenario.sampleRate, scenario.position);
+    
+    for (AnalysisStep step : scenario.analysis) {
+        std::cout << std::endl << "--- " << ScenarioFile::stepName(step) << " ---" << std::endl;
+        
+        switch (step) {
+            case AnalysisStep::SPECTRUM: {
+                FourierAnalyzer analyzer;
+                auto spectrum = analyzer.getSpectrum(signal, scenario.sampleRate);
+                std::cout << "Frequency resolution: " << spectrum.frequencyResolution << " Hz" << std::endl;
+                for (const auto& harmonic : spectrum.harmonics) {
+                    std::cout << "  " << harmonic.order << "° harmonic: "
+                              << harmonic.frequency << " Hz, amplitude: " << harmonic.amplitude << std::endl;
+                }
+                std::cout << "Total Harmonic Distortion: " << analyzer.calculateTHD(spectrum.harmonics) << "%" << std::endl;
+                break;
+            }
+            case AnalysisStep::BEATS:
+                std::cout << "Beat frequency: " << engine.calculateBeatFrequency() << " Hz" << std::endl;
+                break;
+            case AnalysisStep::INTERFERENCE:
+                std::cout << "Interference: " << (engine.detectInterference() ? "yes" : "no") << std::endl;
+                break;
+            case AnalysisStep::PHENOMENON:
+                std::cout << "Phenomenon detected: " << engine.detectPhenomenon() << std::endl;
+                break;
+            case AnalysisStep::ENERGY:
+                std::cout << "Total energy: " << engine.calculateTotalEnergy() << " J" << std::endl;
+                break;
+            case AnalysisStep::STATISTICS: {
+                WaveAnalysis analysis = engine.analyzeWaves(signal, scenario.sampleRate);
+                std::cout << "Max: " << analysis.maxAmplitude << ", min: " << analysis.minAmplitude
+                          << ", RMS: " << analysis.rmsAmplitude << std::endl;
+                break;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runScenario(argv[1]);
+    }
+    
     std::cout << "🌊 Wave Simulator - Console Demonstration 🌊" << std::endl;
     std::cout << "================================================" << std::endl;
     
@@ -125,6 +271,8 @@ int main() {
         demonstrateSuperposition();
         demonstrateInterference();
         demonstrateFourierAnalysis();
+        demonstrateDiffraction();
+        demonstrateFresnelPropagation();
         
         std::cout << std::endl << "=== Demonstration Complete ===" << std::endl;
         std::cout << "For GUI version, compile with: make gui" << std::endl;